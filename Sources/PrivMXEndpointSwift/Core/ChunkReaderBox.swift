@@ -0,0 +1,23 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+import Foundation
+
+/// Holds a Swift reader closure, so it can be passed as the context of a `privmx.ChunkReaderCallback`.
+internal final class ChunkReaderBox: @unchecked Sendable {
+
+	/// Fills the provided buffer and returns the number of bytes written, `0` at the end of the data.
+	let read: (UnsafeMutableRawBufferPointer) -> Int
+
+	init(_ read: @escaping (UnsafeMutableRawBufferPointer) -> Int) {
+		self.read = read
+	}
+}
@@ -0,0 +1,130 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+import Foundation
+import PrivMXEndpointSwiftNative
+
+/// Swift wrapper for `privmx.NativeTransferConfig`, holding process-wide settings of native file transfers shared by all `StoreApi` and `InboxApi` instances.
+public class TransferConfig{
+	
+	/// Limits the memory held by in-flight file chunks across all transfers.
+	///
+	/// When the budget is exhausted, transfers wait for others to return memory instead of failing.
+	/// Chunks returned to Swift stop counting once the call returns. Read-ahead buffers and cached blocks count as well: blocks are cached
+	/// only while the budget has room and are evicted when a transfer has to wait, and chunks prefetched for a handle that is not read
+	/// for 5 seconds are dropped. The budget is unlimited by default.
+	///
+	/// - Parameter bytes: The budget in bytes, `0` removes the limit.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the budget is invalid.
+	public static func setMemoryBudget(
+		_ bytes: Int64
+	) throws -> Void {
+		let res = privmx.NativeTransferConfig.setMemoryBudget(bytes)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+	}
+	
+	/// Gets the current usage of the transfer memory budget.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the usage cannot be read.
+	///
+	/// - Returns: A `privmx.TransferMemoryStats` snapshot.
+	public static func getMemoryStats(
+	) throws -> privmx.TransferMemoryStats {
+		let res = privmx.NativeTransferConfig.getMemoryStats()
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.otherFailure(err)
+		}
+		return result
+	}
+	
+	/// Gets the counters of the pool of chunk staging buffers used by native transfers.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the counters cannot be read.
+	///
+	/// - Returns: A `privmx.TransferBufferPoolStats` snapshot.
+	public static func getBufferPoolStats(
+	) throws -> privmx.TransferBufferPoolStats {
+		let res = privmx.NativeTransferConfig.getBufferPoolStats()
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.otherFailure(err)
+		}
+		return result
+	}
+	
+	/// Frees the buffers kept for reuse by native transfers, e.g. in response to a memory warning.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the pool cannot be trimmed.
+	public static func trimBufferPool(
+	) throws -> Void {
+		let res = privmx.NativeTransferConfig.trimBufferPool()
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+	}
+	
+	/// Enables adapting the chunk size of native uploads and downloads to the link.
+	///
+	/// Starting at `minChunkSize`, the size is doubled while the measured throughput grows and reduced when it drops
+	/// or when a single chunk takes longer than two seconds. Uploads and downloads are tuned separately.
+	/// Disabled by default, in which case 1 MiB chunks are used.
+	///
+	/// - Parameters:
+	///   - enabled: Whether chunk sizes are tuned.
+	///   - minChunkSize: Lower bound of the chunk size in bytes.
+	///   - maxChunkSize: Upper bound of the chunk size in bytes.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the bounds are invalid.
+	public static func setChunkSizeTuning(
+		enabled: Bool,
+		minChunkSize: Int64 = 256 * 1024,
+		maxChunkSize: Int64 = 8 * 1024 * 1024
+	) throws -> Void {
+		let res = privmx.NativeTransferConfig.setChunkSizeTuning(enabled, minChunkSize, maxChunkSize)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+	}
+	
+	/// Gets the chunk sizes currently used by native transfers and the throughput they were chosen for.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the state cannot be read.
+	///
+	/// - Returns: A `privmx.TransferChunkStats` snapshot.
+	public static func getChunkStats(
+	) throws -> privmx.TransferChunkStats {
+		let res = privmx.NativeTransferConfig.getChunkStats()
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.otherFailure(err)
+		}
+		return result
+	}
+}
@@ -286,6 +286,37 @@ public class CryptoApi{
 	}
 	
 	
+	/// Encrypts the given data using AES-256 symmetric encryption, without copying it into a `Buffer` first.
+	///
+	/// - Parameters:
+	///   - data: The data to be encrypted.
+	///   - symmetricKey: The 256-bit key used for encryption (must be the same key used for decryption).
+	///
+	/// - Returns: The encrypted data as a binary buffer.
+	///
+	/// - Throws:
+	///   - `PrivMXEndpointError.failedEncrypting` if the encryption process fails, typically due to an invalid key or data format.
+	///
+	public func encryptDataSymmetric(
+		data: Data,
+		symmetricKey: privmx.endpoint.core.Buffer
+	) throws -> privmx.endpoint.core.Buffer{
+		
+		let res = data.withUnsafeBytes { content in
+			api.encryptDataSymmetric(privmx.makeBufferView(content.baseAddress, content.count), symmetricKey)
+		}
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.failedEncrypting(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.failedEncrypting(err)
+		}
+		return result
+	}
+	
 	/// Decrypts the given data using AES-256 symmetric encryption.
 	///
 	/// This method decrypts data that was previously encrypted using the same symmetric key. If the correct key is not provided, the decryption will fail, resulting in corrupted or unreadable data.
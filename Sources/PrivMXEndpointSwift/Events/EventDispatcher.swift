@@ -0,0 +1,151 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+import Foundation
+import Cxx
+import CxxStdlib
+import PrivMXEndpointSwiftNative
+
+/// Holds a Swift event handler, so it can be passed as the context of a `privmx.EventCallback`.
+internal final class EventHandlerBox: @unchecked Sendable {
+	
+	/// Queue the handler is called on, `nil` calls it on the native thread passing the event.
+	let queue: DispatchQueue?
+	
+	let handler: (privmx.endpoint.core.EventHolder, privmx.EventType) -> Void
+	
+	init(
+		queue: DispatchQueue?,
+		handler: @escaping (privmx.endpoint.core.EventHolder, privmx.EventType) -> Void
+	) {
+		self.queue = queue
+		self.handler = handler
+	}
+	
+	func deliver(
+		_ event: privmx.endpoint.core.EventHolder,
+		_ type: privmx.EventType
+	) {
+		if let queue {
+			queue.async { self.handler(event, type) }
+		} else {
+			handler(event, type)
+		}
+	}
+}
+
+/// Swift wrapper for `privmx.NativeEventDispatcher`, which takes the events from the event queue on a native thread
+/// and passes them to handlers subscribed by event type and container.
+///
+/// Replaces a loop of `EventQueue.waitEvent()` calls, so no Swift thread is blocked waiting for events.
+/// Only one dispatcher can run at a time and no other code should take events from the `EventQueue` while it runs.
+/// The dispatcher is stopped when `stop()` is called or the instance is released.
+public class EventDispatcher{
+	
+	/// An instance of the wrapped C++ class.
+	internal var api: privmx.NativeEventDispatcher
+	
+	/// Starts a new dispatcher.
+	///
+	/// - Parameter workerCount: Number of native threads calling the handlers, `0` (the default) calls them on the dispatching thread.
+	/// With workers, the events of a single Thread, Store or Inbox are still passed in order.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the dispatcher cannot be started, e.g. when another one is running.
+	///
+	/// - Returns: A running `EventDispatcher` instance.
+	public static func create(
+		workerCount: Int64 = 0
+	) throws -> EventDispatcher {
+		let res = privmx.NativeEventDispatcher.create(workerCount)
+		guard res.error.value == nil else{
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+		guard let result = res.result.value else{
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.otherFailure(err)
+		}
+		return EventDispatcher(api: result)
+	}
+	
+	private init(
+		api: privmx.NativeEventDispatcher
+	){
+		self.api = api
+	}
+	
+	/// Subscribes a handler to events.
+	///
+	/// Without a `queue` the handler runs on a native thread and should return quickly, as it holds back the following events.
+	///
+	/// - Parameters:
+	///   - eventType: Type of the events, `.Unknown` (the default) subscribes to events of every type.
+	///   - containerId: ID of the Thread, Store or Inbox of the events, empty (the default) for events of every container.
+	///   - queue: Queue the handler is called on, `nil` (the default) calls it on the native thread passing the event.
+	///   - handler: Receives the events and their types.
+	///
+	/// - Throws: `PrivMXEndpointError.failedSubscribingForEvents` if the subscription cannot be added.
+	///
+	/// - Returns: ID of the subscription, used to end it with `unsubscribe(subscriptionId:)`.
+	public func subscribe(
+		eventType: privmx.EventType = .Unknown,
+		containerId: std.string = "",
+		queue: DispatchQueue? = nil,
+		handler: @escaping (privmx.endpoint.core.EventHolder, privmx.EventType) -> Void
+	) throws -> Int64 {
+		let box = Unmanaged.passRetained(EventHandlerBox(queue: queue, handler: handler))
+		let res = api.subscribe(eventType, containerId, { context, event, type in
+			let box = Unmanaged<EventHandlerBox>.fromOpaque(context!).takeUnretainedValue()
+			box.deliver(event!.pointee, type)
+		}, box.toOpaque(), { context in
+			Unmanaged<EventHandlerBox>.fromOpaque(context!).release()
+		})
+		guard res.error.value == nil else {
+			box.release()
+			throw PrivMXEndpointError.failedSubscribingForEvents(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.failedSubscribingForEvents(err)
+		}
+		return result
+	}
+	
+	/// Ends a subscription.
+	///
+	/// A handler running at the moment is not interrupted, events not passed to the handler yet are dropped.
+	///
+	/// - Parameter subscriptionId: ID returned by `subscribe(eventType:containerId:queue:handler:)`.
+	///
+	/// - Throws: `PrivMXEndpointError.failedUnsubscribingFromEvents` if the subscription is unknown.
+	public func unsubscribe(
+		subscriptionId: Int64
+	) throws -> Void {
+		let res = api.unsubscribe(subscriptionId)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.failedUnsubscribingFromEvents(res.error.value!)
+		}
+	}
+	
+	/// Stops taking events from the queue, ends all subscriptions and waits for the running handlers.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the dispatcher cannot be stopped.
+	public func stop(
+	) throws -> Void {
+		let res = api.stop()
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+	}
+}
@@ -1107,5 +1107,51 @@ public enum EventHandler{
 		}
 		return result
 	}
+	
+	/// Gets the type of the event contained in the `EventHolder` in a single call.
+	///
+	/// Use it instead of a chain of `is*Event` checks, then read the event with the matching `extract*Event` method.
+	///
+	/// - Parameter eventHolder: The `EventHolder` instance to be classified.
+	/// - Returns: The `EventType` of the event, `.Unknown` for events without a dedicated type.
+	/// - Throws: `PrivMXEndpointError.failedQueryingEventHolder` if an error occurs in the underlying C++ code or another issue arises.
+	public static func classifyEvent(
+		eventHolder: privmx.endpoint.core.EventHolder
+	) throws -> privmx.EventType {
+		let res = privmx.EventClassifier.classifyEvent(eventHolder)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.failedQueryingEventHolder(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.failedQueryingEventHolder(err)
+		}
+		return result
+	}
+	
+	/// Gets the ID of the Thread, Store or Inbox the event contained in the `EventHolder` concerns.
+	///
+	/// The ID is read without extracting the whole event.
+	///
+	/// - Parameter eventHolder: The `EventHolder` instance to be queried.
+	/// - Returns: The ID of the container, an empty string for connection and break events.
+	/// - Throws: `PrivMXEndpointError.failedQueryingEventHolder` if an error occurs in the underlying C++ code or another issue arises.
+	public static func getEventContainerId(
+		eventHolder: privmx.endpoint.core.EventHolder
+	) throws -> std.string {
+		let res = privmx.EventClassifier.getEventContainerId(eventHolder)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.failedQueryingEventHolder(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.failedQueryingEventHolder(err)
+		}
+		return result
+	}
 
 }
@@ -107,4 +107,100 @@ public class EventQueue {
 		return result.value
 	}
 	
+	/// Takes up to `maxCount` events from the queue in a single call.
+	///
+	/// Waits for the first event at most `timeoutMs`, then drains the events already available without waiting again,
+	/// so a burst of events costs one call instead of one per event. A break event ends the batch.
+	///
+	/// - Parameters:
+	///   - maxCount: Maximum number of returned events, must be positive.
+	///   - timeoutMs: Time in milliseconds to wait for the first event, `0` returns at once, a negative value waits indefinitely.
+	///
+	/// - Returns: Events in the order they arrived, empty if none arrived in time.
+	/// - Throws: `PrivMXEndpointError.failedWaitingForEvent` if an error occurs while waiting for the events.
+	public func waitEvents(
+		maxCount: Int64 = 256,
+		timeoutMs: Int64 = -1
+	) throws -> privmx.EventHolderVector{
+		let res = api.waitEvents(maxCount, timeoutMs)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.failedWaitingForEvent(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.failedWaitingForEvent(err)
+		}
+		return result
+	}
+	
+	/// Sets which types of events are handed over by the queue and by `EventDispatcher`.
+	///
+	/// Other events are dropped natively, before they reach Swift. Break events are never dropped.
+	/// The filter is shared by all instances, like the queue itself.
+	///
+	/// - Parameters:
+	///   - allowed: Types passed on, empty for all types not denied.
+	///   - denied: Types dropped.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the filter cannot be set.
+	public func setEventTypeFilter(
+		allowed: privmx.EventTypeVector,
+		denied: privmx.EventTypeVector
+	) throws -> Void{
+		let res = api.setEventTypeFilter(allowed, denied)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+	}
+	
+	/// Sets the Threads, Stores and Inboxes whose events are handed over by the queue and by `EventDispatcher`.
+	///
+	/// Events not concerning a single container, e.g. connection events, are not affected.
+	///
+	/// - Parameters:
+	///   - allowed: IDs of the containers whose events are passed on, empty for all containers not denied.
+	///   - denied: IDs of the containers whose events are dropped.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the filter cannot be set.
+	public func setContainerFilter(
+		allowed: privmx.StringVector,
+		denied: privmx.StringVector
+	) throws -> Void{
+		let res = api.setContainerFilter(allowed, denied)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+	}
+	
+	/// Removes the filters set by `setEventTypeFilter(allowed:denied:)` and `setContainerFilter(allowed:denied:)`.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the filters cannot be removed.
+	public func clearEventFilter(
+	) throws -> Void{
+		let res = api.clearEventFilter()
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+	}
+	
+	/// Sets the window in which stats and update events are coalesced before they are handed over.
+	///
+	/// Within the window only the latest `ThreadStatsChanged`, `StoreStatsChanged`, `ThreadUpdated`, `StoreUpdated` and `InboxUpdated`
+	/// event of each Thread, Store or Inbox is kept. Other events of the container hand over the held ones first, so their order is kept.
+	/// Applies to the queue and to `EventDispatcher`, and is shared by all instances.
+	///
+	/// - Parameter windowMs: Length of the window in milliseconds, `0` disables coalescing and hands over the held events.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the window is negative.
+	public func setEventCoalescing(
+		windowMs: Int64
+	) throws -> Void{
+		let res = api.setEventCoalescing(windowMs)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+	}
+	
 }
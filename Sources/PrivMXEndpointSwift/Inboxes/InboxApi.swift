@@ -304,6 +304,47 @@ public func prepareEntry(
 		return result
 	}
 	
+	/// Prepares a new entry to be sent to the Inbox, without copying `data` into a `Buffer` first.
+	///
+	/// - Parameters:
+	///   - inboxId: The ID of the Inbox to which the entry will be sent.
+	///   - data: The data to be included in the entry.
+	///   - inboxFileHandles: An optional vector of file handles to be attached to the entry. By default, no files are attached.
+	///   - userPrivKey: An optional private key of the user preparing the entry, if required.
+	///
+	/// - Throws: `PrivMXEndpointError.failedPreparingEntry` if preparing the entry fails.
+	///
+	/// - Returns: An `InboxHandle` representing the prepared entry, which should then be sent.
+	public func prepareEntry(
+		inboxId: std.string,
+		data: Data,
+		inboxFileHandles: privmx.InboxFileHandleVector = [],
+		userPrivKey: std.string? = nil
+	) throws -> privmx.InboxHandle {
+		
+		var opk = privmx.OptionalString()
+		if let userPrivKey{
+			opk = privmx.makeOptional(userPrivKey)
+		}
+		
+		let res = data.withUnsafeBytes { content in
+			api.prepareEntry(inboxId,
+							 privmx.makeBufferView(content.baseAddress, content.count),
+							 inboxFileHandles,
+							 opk)
+		}
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.failedPreparingEntry(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.failedPreparingEntry(err)
+		}
+		return result
+	}
+	
 	/// Sends a previously prepared entry to the Inbox.
 	///
 	/// This method finalizes the process by sending the entry to the specified Inbox.
@@ -437,6 +478,198 @@ public func prepareEntry(
 		}
 	}
 	
+	/// Writes a chunk of data to a file in the Inbox, without copying it into a `Buffer` first.
+	///
+	/// - Parameters:
+	///   - inboxHandle: Handle to the prepared Inbox entry
+	///   - inboxFileHandle: handle to the file where the uploaded chunk belongs
+	///   - dataChunk: file chunk to send
+	///
+	/// - Throws: `PrivMXEndpointError.failedWritingToFile` if writing the data chunk fails.
+	public func writeToFile(
+		inboxHandle: privmx.InboxHandle,
+		inboxFileHandle: privmx.InboxFileHandle,
+		dataChunk: Data
+	) throws -> Void {
+		let res = dataChunk.withUnsafeBytes { chunk in
+			api.writeToFile(inboxHandle,
+							inboxFileHandle,
+							privmx.makeBufferView(chunk.baseAddress, chunk.count))
+		}
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.failedWritingToFile(res.error.value!)
+		}
+	}
+	
+	/// Sends the whole content of a local file to a file in the Inbox.
+	///
+	/// The source is memory-mapped natively and sent chunk by chunk, so it never has to be loaded into `Data`.
+	///
+	/// - Parameters:
+	///   - inboxHandle: Handle to the prepared Inbox entry
+	///   - inboxFileHandle: handle to the file where the content belongs, created with the size of the source file
+	///   - filePath: Path of the source file.
+	///
+	/// - Throws: `PrivMXEndpointError.failedWritingToFile` if reading the source or sending it fails.
+	public func writeFileFromPath(
+		inboxHandle: privmx.InboxHandle,
+		inboxFileHandle: privmx.InboxFileHandle,
+		filePath: std.string
+	) throws -> Void {
+		let res = api.writeFileFromPath(inboxHandle, inboxFileHandle, filePath)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.failedWritingToFile(res.error.value!)
+		}
+	}
+	
+	/// Sends the whole content of a local file to a file in the Inbox like `writeFileFromPath()`, computing SHA-256 of the content on the way.
+	///
+	/// - Parameters:
+	///   - inboxHandle: Handle to the prepared Inbox entry
+	///   - inboxFileHandle: handle to the file where the content belongs, created with the size of the source file
+	///   - filePath: Path of the source file.
+	///
+	/// - Throws: `PrivMXEndpointError.failedWritingToFile` if reading the source or sending it fails.
+	///
+	/// - Returns: The number of bytes sent and their SHA-256; the file ID is assigned once the entry is sent.
+	public func writeFileFromPathWithDigest(
+		inboxHandle: privmx.InboxHandle,
+		inboxFileHandle: privmx.InboxFileHandle,
+		filePath: std.string
+	) throws -> privmx.FileDigest {
+		let res = api.writeFileFromPathWithDigest(inboxHandle, inboxFileHandle, filePath)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.failedWritingToFile(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.failedWritingToFile(err)
+		}
+		return result
+	}
+	
+	/// Downloads a file attached to an Inbox entry like `downloadFileToPath()`, computing SHA-256 of the content on the way.
+	///
+	/// - Parameters:
+	///   - fileId: The unique identifier of the file to download.
+	///   - filePath: Path of the target file, overwritten if it exists.
+	///   - syncInterval: Amount of bytes after which the written data is flushed to the storage device, `0` (the default) disables syncing.
+	///
+	/// - Throws: `PrivMXEndpointError.failedReadingFromFile` if reading the file or writing the target fails.
+	///
+	/// - Returns: The ID of the file, the number of bytes written and their SHA-256.
+	public func downloadFileToPathWithDigest(
+		fileId: std.string,
+		filePath: std.string,
+		syncInterval: Int64 = 0
+	) throws -> privmx.FileDigest {
+		let res = api.downloadFileToPathWithDigest(fileId, filePath, syncInterval)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.failedReadingFromFile(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.failedReadingFromFile(err)
+		}
+		return result
+	}
+	
+	/// Downloads a file attached to an Inbox entry to the local filesystem.
+	///
+	/// The decrypted content is written natively, without being copied into `Data`. The target appears at `filePath` only once the whole content has been written.
+	///
+	/// - Parameters:
+	///   - fileId: The unique identifier of the file to download.
+	///   - filePath: Path of the target file, overwritten if it exists.
+	///   - syncInterval: Amount of bytes after which the written data is flushed to the storage device, `0` (the default) disables syncing.
+	///
+	/// - Throws: `PrivMXEndpointError.failedReadingFromFile` if reading the file or writing the target fails.
+	///
+	/// - Returns: The number of bytes written.
+	public func downloadFileToPath(
+		fileId: std.string,
+		filePath: std.string,
+		syncInterval: Int64 = 0
+	) throws -> Int64 {
+		let res = api.downloadFileToPath(fileId, filePath, syncInterval)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.failedReadingFromFile(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.failedReadingFromFile(err)
+		}
+		return result
+	}
+	
+	/// Labels an open file handle, e.g. with the call site that opened it.
+	///
+	/// The label is reported by `getLiveFileHandles()`, so handles that are never closed can be traced back to their owners.
+	///
+	/// - Parameters:
+	///   - fileHandle: The handle to the open file.
+	///   - label: Any text identifying the owner of the handle.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the label could not be set.
+	public func setFileHandleLabel(
+		fileHandle: privmx.InboxFileHandle,
+		label: std.string
+	) throws -> Void {
+		let res = api.setFileHandleLabel(fileHandle, label)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+	}
+	
+	/// Lists the file handles returned by `openFile()` and not closed yet, oldest first.
+	///
+	/// Each entry reports the file, the label, the data buffered natively and the age of the handle, which helps finding the code that leaks handles.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the handles could not be listed.
+	///
+	/// - Returns: Snapshots of the live handles.
+	public func getLiveFileHandles(
+	) throws -> privmx.LiveFileHandleVector {
+		let res = api.getLiveFileHandles()
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.otherFailure(err)
+		}
+		return result
+	}
+	
+	/// Opens a file for reading from the Inbox, with the handle owned by the returned object.
+	///
+	/// The handle is closed when the returned owner is released, and is labelled with the calling site for `getLiveFileHandles()`.
+	///
+	/// - Parameters:
+	///   - fileId: The ID of the file to be opened.
+	///
+	/// - Throws: `PrivMXEndpointError.failedOpeningFile` if opening the file fails.
+	///
+	/// - Returns: The owner of the new handle.
+	public func openOwnedFile(
+		fileId: std.string,
+		file: String = #fileID,
+		line: Int = #line
+	) throws -> OwnedInboxFileHandle {
+		let handle = try openFile(fileId: fileId)
+		let owner = OwnedInboxFileHandle(handle: handle, inboxApi: self)
+		try setFileHandleLabel(fileHandle: handle, label: std.string("\(file):\(line)"))
+		return owner
+	}
+	
 	/// Opens a file for reading from the Inbox.
 	///
 	/// - Parameter fileId: The ID of the file to open.
@@ -487,6 +720,65 @@ public func prepareEntry(
 		return result
 	}
 	
+	/// Reads data from an open file in the inbox straight into the provided memory.
+	///
+	/// - Parameters:
+	///   - fileHandle: The file handle to read from.
+	///   - buffer: Destination of the read data; at most `buffer.count` bytes are read.
+	///
+	/// - Throws: `PrivMXEndpointError.failedReadingFromFile` if reading from the file fails.
+	///
+	/// - Returns: The number of bytes read, `0` at the end of the file.
+	public func readFromFile(
+		fileHandle: privmx.InboxFileHandle,
+		into buffer: UnsafeMutableRawBufferPointer
+	) throws -> Int {
+		let res = api.readFromFileInto(fileHandle,
+									   buffer.baseAddress,
+									   buffer.count)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.failedReadingFromFile(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.failedReadingFromFile(err)
+		}
+		return Int(result)
+	}
+	
+	/// Reads a fragment of a file in the inbox without opening it first.
+	///
+	/// Opening, seeking and reading happen in a single native call; the handle is kept open for the next `readRange` of the same file.
+	/// Handles returned by `openFile` are not affected.
+	///
+	/// - Parameters:
+	///   - fileId: The ID of the file to read.
+	///   - offset: The position of the first byte to read.
+	///   - length: The maximum number of bytes to read.
+	///
+	/// - Throws: `PrivMXEndpointError.failedReadingFromFile` if reading from the file fails.
+	///
+	/// - Returns: A buffer containing the read data, shorter than `length` at the end of the file.
+	public func readRange(
+		fileId: std.string,
+		offset: Int64,
+		length: Int64
+	) throws -> privmx.endpoint.core.Buffer {
+		let res = api.readRange(fileId, offset, length)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.failedReadingFromFile(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.failedReadingFromFile(err)
+		}
+		return result
+	}
+	
 	/// Moves the read cursor in an open file.
     ///
     /// - Parameters:
@@ -505,6 +797,81 @@ public func prepareEntry(
 		}
 	}
 	
+	/// Enables caching of decrypted blocks for randomly accessed files.
+	///
+	/// Reads of opened handles fetch whole blocks and keep them in a least-recently-used cache, so repeated and nearby reads after `seekInFile()` are served from memory.
+	///
+	/// - Parameter bytes: Maximum amount of decrypted data kept in memory, `0` (the default) disables the cache.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the setting could not be applied.
+	public func setBlockCacheSize(
+		bytes: Int64
+	) throws -> Void {
+		let res = api.setBlockCacheSize(bytes)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+	}
+	
+	/// Enables asynchronous writes to prepared entries.
+	///
+	/// `writeToFile` then copies the chunk and returns as soon as it is queued, while a native worker writes the previous chunk,
+	/// so preparing the next chunk overlaps with encrypting and sending the previous one.
+	/// A failed write is reported by the next `writeToFile` of the entry or by `sendEntry`. Disabled by default.
+	///
+	/// - Parameter enabled: Whether `writeToFile` returns before the chunk is written.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the setting could not be applied.
+	public func setAsyncWrites(
+		enabled: Bool
+	) throws -> Void {
+		let res = api.setAsyncWrites(enabled)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+	}
+	
+	/// Starts computing SHA-256 of the data read through a handle returned by `openFile()`.
+	///
+	/// Only data read after this call is covered, in the order it was read; seeking does not reset the digest.
+	///
+	/// - Parameter fileHandle: The handle to the open file.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the digest could not be enabled.
+	public func enableFileDigest(
+		fileHandle: privmx.InboxFileHandle
+	) throws -> Void {
+		let res = api.enableFileDigest(fileHandle)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+	}
+	
+	/// Closes an open file in the Inbox, returning the digest started by `enableFileDigest()`.
+	///
+	/// Fails without closing the handle if the digest was not enabled.
+	///
+	/// - Parameter fileHandle: The handle to the open file.
+	///
+	/// - Throws: `PrivMXEndpointError.failedClosingFile` if closing the file fails.
+	///
+	/// - Returns: The ID of the file, the number of covered bytes and their SHA-256.
+	public func closeFileWithDigest(
+		fileHandle: privmx.InboxFileHandle
+	) throws -> privmx.FileDigest {
+		let res = api.closeFileWithDigest(fileHandle)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.failedClosingFile(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.failedClosingFile(err)
+		}
+		return result
+	}
+	
 	/// Closes an open file in the Inbox.
     ///
     /// - Parameter fileHandle: The file handle to close.
@@ -0,0 +1,55 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+import Foundation
+import Cxx
+import CxxStdlib
+import PrivMXEndpointSwiftNative
+
+/// Owner of an open Store file handle, closing it when released.
+///
+/// Keeps the native handle and its buffers from leaking when code throws between opening and closing a file.
+/// Errors of the implicit close are ignored; call `close()` to handle them.
+public final class OwnedStoreFileHandle{
+	
+	/// The owned handle, to be passed to the `StoreApi` methods. Must not be closed through `StoreApi` directly.
+	public let handle: privmx.StoreFileHandle
+	
+	private let storeApi: StoreApi
+	private var isOpen = true
+	
+	internal init(
+		handle: privmx.StoreFileHandle,
+		storeApi: StoreApi
+	){
+		self.handle = handle
+		self.storeApi = storeApi
+	}
+	
+	deinit{
+		if isOpen {
+			_ = try? storeApi.closeFile(handle: handle)
+		}
+	}
+	
+	/// Closes the handle.
+	///
+	/// The handle is not closed again on release, even if closing fails.
+	///
+	/// - Throws: `PrivMXEndpointError.failedClosingFile` if closing the file fails.
+	///
+	/// - Returns: The ID of the closed file.
+	@discardableResult
+	public func close() throws -> std.string {
+		isOpen = false
+		return try storeApi.closeFile(handle: handle)
+	}
+}
@@ -332,6 +332,82 @@ public class StoreApi{
 		}
 	}
 	
+	/// Enables prefetching for sequentially read files.
+	///
+	/// After a handle has been read a few times in a row with the same length, the following chunks are downloaded
+	/// in the background and served to later `readFromFile()` calls. Seeking drops the prefetched data, and so does not reading the handle for 5 seconds.
+	///
+	/// - Parameter chunkCount: Maximum number of chunks buffered per handle, `0` disables read-ahead.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the setting could not be applied.
+	public func setReadAheadDepth(
+		chunkCount: Int64
+	) throws -> Void {
+		let res = api.setReadAheadDepth(chunkCount)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+	}
+	
+	/// Enables caching of decrypted blocks for randomly accessed files.
+	///
+	/// Reads of opened handles fetch whole blocks and keep them in a least-recently-used cache, so repeated and nearby reads after `seekInFile()` are served from memory.
+	/// Cached blocks of a file are dropped when it is updated or deleted through this instance, or when its `StoreFileUpdatedEvent` or `StoreFileDeletedEvent`
+	/// is taken from the `EventQueue` or passes through an `EventDispatcher`. Changes made by other clients are seen only through those events, so enable the cache
+	/// only while subscribed to the file events of the Stores read and draining the queue, otherwise reads of a file changed elsewhere return stale content.
+	///
+	/// - Parameter bytes: Maximum amount of decrypted data kept in memory, `0` (the default) disables the cache.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the setting could not be applied.
+	public func setBlockCacheSize(
+		bytes: Int64
+	) throws -> Void {
+		let res = api.setBlockCacheSize(bytes)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+	}
+	
+	/// Enables asynchronous writes to file handles.
+	///
+	/// `writeToFile` then copies the chunk and returns as soon as it is queued, while a native worker writes the previous chunk,
+	/// so preparing the next chunk overlaps with encrypting and sending the previous one.
+	/// A failed write is reported by the next `writeToFile` or `closeFile` of the handle, which then still releases the handle. Disabled by default.
+	///
+	/// - Parameter enabled: Whether `writeToFile` returns before the chunk is written.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the setting could not be applied.
+	public func setAsyncWrites(
+		enabled: Bool
+	) throws -> Void {
+		let res = api.setAsyncWrites(enabled)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+	}
+	
+	/// Sets the limits of the pool of open read handles, which is disabled by default.
+	///
+	/// `closeFile()` on a handle returned by `openFile()` keeps it open in the pool, and the next `openFile()` or `readRange()` of the same file reuses it.
+	/// Pooled handles of a file are dropped when it is updated or deleted through this instance, or when its `StoreFileUpdatedEvent` or `StoreFileDeletedEvent`
+	/// is taken from the `EventQueue` or passes through an `EventDispatcher`. Enable the pool only while subscribed to the file events of the Stores read
+	/// and draining the queue, otherwise a file changed by another client is read from a stale handle until the handle times out.
+	///
+	/// - Parameters:
+	///   - maxIdleHandles: Maximum number of idle handles kept open, `0` disables pooling (default 0).
+	///   - idleTimeoutMs: Time in milliseconds after which an idle handle is closed, `0` keeps idle handles until evicted (default 30000).
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the setting could not be applied.
+	public func setOpenHandlePoolLimits(
+		maxIdleHandles: Int64,
+		idleTimeoutMs: Int64
+	) throws -> Void {
+		let res = api.setOpenHandlePoolLimits(maxIdleHandles, idleTimeoutMs)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+	}
+	
 	/// Updates an existing file within a Store.
     ///
     /// This method creates a new handle for updating the file's content and metadata. Use `writeToFile()` to upload data and `closeFile()` to finalize the update.
@@ -407,6 +483,163 @@ public class StoreApi{
 		return result
 	}
 	
+	/// Labels an open file handle, e.g. with the call site that opened it.
+	///
+	/// The label is reported by `getLiveFileHandles()`, so handles that are never closed can be traced back to their owners.
+	///
+	/// - Parameters:
+	///   - handle: The handle to the open file.
+	///   - label: Any text identifying the owner of the handle.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the label could not be set.
+	public func setFileHandleLabel(
+		handle: privmx.StoreFileHandle,
+		label: std.string
+	) throws -> Void {
+		let res = api.setFileHandleLabel(handle, label)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+	}
+	
+	/// Lists the file handles returned by `openFile()`, `createFile()` and `updateFile()` and not closed yet, oldest first.
+	///
+	/// Each entry reports the file, the label, the data buffered natively and the age of the handle, which helps finding the code that leaks handles.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the handles could not be listed.
+	///
+	/// - Returns: Snapshots of the live handles.
+	public func getLiveFileHandles(
+	) throws -> privmx.LiveFileHandleVector {
+		let res = api.getLiveFileHandles()
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.otherFailure(err)
+		}
+		return result
+	}
+	
+	/// Opens a file for reading, with the handle owned by the returned object.
+	///
+	/// The handle is closed when the returned owner is released, and is labelled with the calling site for `getLiveFileHandles()`.
+	///
+	/// - Parameters:
+	///   - fileId: The unique identifier of the file to be opened.
+	///
+	/// - Throws: `PrivMXEndpointError.failedOpeningFile` if opening the file fails.
+	///
+	/// - Returns: The owner of the new handle.
+	public func openOwnedFile(
+		fileId: std.string,
+		file: String = #fileID,
+		line: Int = #line
+	) throws -> OwnedStoreFileHandle {
+		let handle = try openFile(fileId: fileId)
+		let owner = OwnedStoreFileHandle(handle: handle, storeApi: self)
+		try setFileHandleLabel(handle: handle, label: std.string("\(file):\(line)"))
+		return owner
+	}
+	
+	/// Creates a new file handle for writing in a Store, owned by the returned object.
+	///
+	/// The handle is closed when the returned owner is released, and is labelled with the calling site for `getLiveFileHandles()`.
+	///
+	/// - Parameters:
+	///   - storeId: The Store in which the file should be created.
+	///   - publicMeta: Public metadata for the file.
+	///   - privateMeta: Private metadata for the file.
+	///   - size: The size of the file in bytes.
+	///
+	/// - Throws: `PrivMXEndpointError.failedCreatingFile` if creating the file handle fails.
+	///
+	/// - Returns: The owner of the new handle.
+	public func createOwnedFile(
+		storeId: std.string,
+		publicMeta: privmx.endpoint.core.Buffer,
+		privateMeta: privmx.endpoint.core.Buffer,
+		size: Int64,
+		file: String = #fileID,
+		line: Int = #line
+	) throws -> OwnedStoreFileHandle {
+		let handle = try createFile(storeId: storeId, publicMeta: publicMeta, privateMeta: privateMeta, size: size)
+		let owner = OwnedStoreFileHandle(handle: handle, storeApi: self)
+		try setFileHandleLabel(handle: handle, label: std.string("\(file):\(line)"))
+		return owner
+	}
+	
+	/// Creates a handle replacing the content of an existing file, owned by the returned object.
+	///
+	/// The handle is closed when the returned owner is released, and is labelled with the calling site for `getLiveFileHandles()`.
+	///
+	/// - Parameters:
+	///   - fileId: The unique identifier of the file to be updated.
+	///   - publicMeta: New public metadata for the file.
+	///   - privateMeta: New private metadata for the file.
+	///   - size: The new size of the file in bytes.
+	///
+	/// - Throws: `PrivMXEndpointError.failedUpdatingFile` if updating the file fails.
+	///
+	/// - Returns: The owner of the new handle.
+	public func updateOwnedFile(
+		fileId: std.string,
+		publicMeta: privmx.endpoint.core.Buffer,
+		privateMeta: privmx.endpoint.core.Buffer,
+		size: Int64,
+		file: String = #fileID,
+		line: Int = #line
+	) throws -> OwnedStoreFileHandle {
+		let handle = try updateFile(fileId: fileId, publicMeta: publicMeta, privateMeta: privateMeta, size: size)
+		let owner = OwnedStoreFileHandle(handle: handle, storeApi: self)
+		try setFileHandleLabel(handle: handle, label: std.string("\(file):\(line)"))
+		return owner
+	}
+	
+	/// Starts computing SHA-256 of the data read through or written to an open file.
+	///
+	/// Only data passed after this call is covered, in the order it was read or written; seeking does not reset the digest.
+	///
+	/// - Parameter handle: The handle to the open file.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the digest could not be enabled.
+	public func enableFileDigest(
+		handle: privmx.StoreFileHandle
+	) throws -> Void {
+		let res = api.enableFileDigest(handle)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+	}
+	
+	/// Closes an open file, returning the digest started by `enableFileDigest()`.
+	///
+	/// Fails without closing the handle if the digest was not enabled.
+	///
+	/// - Parameter handle: The handle to the open file.
+	///
+	/// - Throws: `PrivMXEndpointError.failedClosingFile` if closing the file fails.
+	///
+	/// - Returns: The ID of the file, the number of covered bytes and their SHA-256.
+	public func closeFileWithDigest(
+		handle: privmx.StoreFileHandle
+	) throws -> privmx.FileDigest {
+		let res = api.closeFileWithDigest(handle)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.failedClosingFile(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.failedClosingFile(err)
+		}
+		return result
+	}
+	
 	/// Opens a file for reading from the Store.
     ///
     /// - Parameter fileId: The unique identifier of the file to be opened.
@@ -457,6 +690,63 @@ public class StoreApi{
 		return result
 	}
 	
+	/// Reads data from an open file straight into the provided memory.
+	///
+	/// - Parameters:
+	///   - handle: The handle to the open file.
+	///   - buffer: Destination of the read data; at most `buffer.count` bytes are read.
+	///
+	/// - Throws: `PrivMXEndpointError.failedReadingFromFile` if reading from the file fails.
+	///
+	/// - Returns: The number of bytes read, `0` at the end of the file.
+	public func readFromFile(
+		handle: privmx.StoreFileHandle,
+		into buffer: UnsafeMutableRawBufferPointer
+	) throws -> Int {
+		let res = api.readFromFileInto(handle, buffer.baseAddress, buffer.count)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.failedReadingFromFile(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.failedReadingFromFile(err)
+		}
+		return Int(result)
+	}
+	
+	/// Reads a fragment of a file without opening it first.
+	///
+	/// Opening, seeking and reading happen in a single native call; when the pool of open handles is enabled, the handle is kept in it for the next read of the same file.
+	/// Handles held by the caller are not affected.
+	///
+	/// - Parameters:
+	///   - fileId: The ID of the file to read.
+	///   - offset: The position of the first byte to read.
+	///   - length: The maximum number of bytes to read.
+	///
+	/// - Throws: `PrivMXEndpointError.failedReadingFromFile` if reading from the file fails.
+	///
+	/// - Returns: A buffer containing the read data, shorter than `length` at the end of the file.
+	public func readRange(
+		fileId: std.string,
+		offset: Int64,
+		length: Int64
+	) throws -> privmx.endpoint.core.Buffer {
+		let res = api.readRange(fileId, offset, length)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.failedReadingFromFile(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.failedReadingFromFile(err)
+		}
+		return result
+	}
+	
 	/// Writes a chunk of data to an open file on the platform.
     ///
     /// - Parameters:
@@ -475,6 +765,25 @@ public class StoreApi{
 		}
 	}
 	
+	/// Writes a chunk of data to an open file on the platform, without copying it into a `Buffer` first.
+	///
+	/// - Parameters:
+	///   - handle: The handle to the open file.
+	///   - dataChunk: The chunk of data to be written to the file.
+	///
+	/// - Throws: `PrivMXEndpointError.failedWritingToFile` if writing to the file fails.
+	public func writeToFile(
+		handle: privmx.StoreFileHandle,
+		dataChunk: Data
+	) throws -> Void{
+		let res = dataChunk.withUnsafeBytes { chunk in
+			api.writeToFile(handle, privmx.makeBufferView(chunk.baseAddress, chunk.count))
+		}
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.failedWritingToFile(res.error.value!)
+		}
+	}
+	
 	/// Deletes a specified file from the Store.
     ///
     /// - Parameter fileId: The unique identifier of the file to delete.
@@ -488,7 +797,308 @@ public class StoreApi{
 			throw PrivMXEndpointError.failedDeletingFile(res.error.value!)
 		}
 	}
+
+	/// Uploads a local file to a Store at most once, keeping a record of the upload in a file.
+	///
+	/// The record is written when the upload starts and replaced when it completes. If it shows that the same unchanged source has already been uploaded
+	/// to the same Store and that file still exists, its ID is returned without uploading again, so the call can be safely repeated, e.g. after a restart.
+	/// An interrupted upload is not continued, it starts over. Failing to update the record after the file has been created is not reported.
+	/// The record is kept after completion — remove it once the file ID has been stored elsewhere.
+	///
+	/// - Parameters:
+	///   - storeId: The Store in which the file should be created.
+	///   - publicMeta: Public metadata for the file.
+	///   - privateMeta: Private metadata for the file.
+	///   - filePath: Path of the source file.
+	///   - recordPath: Path of the record file.
+	///
+	/// - Throws: `PrivMXEndpointError.failedWritingToFile` if the upload fails.
+	///
+	/// - Returns: The ID of the created or previously uploaded file as a `std.string`.
+	public func uploadFileRecorded(
+		storeId: std.string,
+		publicMeta: privmx.endpoint.core.Buffer,
+		privateMeta: privmx.endpoint.core.Buffer,
+		filePath: std.string,
+		recordPath: std.string
+	) throws -> std.string {
+		let res = api.uploadFileRecorded(storeId, publicMeta, privateMeta, filePath, recordPath)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.failedWritingToFile(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.failedWritingToFile(err)
+		}
+		return result
+	}
+	
+	/// Reads a record written by `uploadFileRecorded`.
+	///
+	/// - Parameter recordPath: Path of the record file.
+	///
+	/// - Throws: `PrivMXEndpointError.failedReadingFromFile` if the record cannot be read.
+	///
+	/// - Returns: The record, or `nil` if there is no valid one.
+	public func readUploadRecord(
+		recordPath: std.string
+	) throws -> privmx.UploadRecord? {
+		let res = api.readUploadRecord(recordPath)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.failedReadingFromFile(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.failedReadingFromFile(err)
+		}
+		return result.value
+	}
+	
+	/// Downloads a file from a Store to the local filesystem.
+	///
+	/// The decrypted content is written natively, without being copied into `Data`. The target appears at `filePath` only once the whole content has been written.
+	///
+	/// - Parameters:
+	///   - fileId: The unique identifier of the file to download.
+	///   - filePath: Path of the target file, overwritten if it exists.
+	///   - syncInterval: Amount of bytes after which the written data is flushed to the storage device, `0` (the default) disables syncing.
+	///
+	/// - Throws: `PrivMXEndpointError.failedReadingFromFile` if reading the file or writing the target fails.
+	///
+	/// - Returns: The number of bytes written.
+	public func downloadFileToPath(
+		fileId: std.string,
+		filePath: std.string,
+		syncInterval: Int64 = 0
+	) throws -> Int64 {
+		let res = api.downloadFileToPath(fileId, filePath, syncInterval)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.failedReadingFromFile(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.failedReadingFromFile(err)
+		}
+		return result
+	}
+	
+	/// Downloads a file from a Store to the local filesystem like `downloadFileToPath()`, computing SHA-256 of the content on the way.
+	///
+	/// - Parameters:
+	///   - fileId: The unique identifier of the file to download.
+	///   - filePath: Path of the target file, overwritten if it exists.
+	///   - syncInterval: Amount of bytes after which the written data is flushed to the storage device, `0` (the default) disables syncing.
+	///
+	/// - Throws: `PrivMXEndpointError.failedReadingFromFile` if reading the file or writing the target fails.
+	///
+	/// - Returns: The ID of the file, the number of bytes written and their SHA-256.
+	public func downloadFileToPathWithDigest(
+		fileId: std.string,
+		filePath: std.string,
+		syncInterval: Int64 = 0
+	) throws -> privmx.FileDigest {
+		let res = api.downloadFileToPathWithDigest(fileId, filePath, syncInterval)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.failedReadingFromFile(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.failedReadingFromFile(err)
+		}
+		return result
+	}
+	
+	/// Uploads a file from the local filesystem to a Store like `uploadFile(storeId:publicMeta:privateMeta:filePath:)`, computing SHA-256 of the content on the way.
+	///
+	/// - Parameters:
+	///   - storeId: The Store in which the file should be created.
+	///   - publicMeta: Public metadata for the file.
+	///   - privateMeta: Private metadata for the file.
+	///   - filePath: Path of the source file.
+	///
+	/// - Throws: `PrivMXEndpointError.failedWritingToFile` if reading the source or uploading it fails.
+	///
+	/// - Returns: The ID of the created file, the number of bytes uploaded and their SHA-256.
+	public func uploadFileWithDigest(
+		storeId: std.string,
+		publicMeta: privmx.endpoint.core.Buffer,
+		privateMeta: privmx.endpoint.core.Buffer,
+		filePath: std.string
+	) throws -> privmx.FileDigest {
+		let res = api.uploadFileWithDigest(storeId, publicMeta, privateMeta, filePath)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.failedWritingToFile(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.failedWritingToFile(err)
+		}
+		return result
+	}
+	
+	/// Enables skipping uploads of content already present in the target Store.
+	///
+	/// Uploads from a path first hash the source and look it up in a local index of uploaded content. A file listed there is returned
+	/// instead of uploading again if it still exists, has the same size and metadata and its leading 64 KiB still match the uploaded content. Files updated or deleted through this instance
+	/// or reported by Store events taken from the event queue are dropped from the index.
+	///
+	/// - Parameter indexPath: File in which the index is kept between sessions, empty to keep it in memory only.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the index could not be enabled.
+	public func enableUploadDeduplication(
+		indexPath: std.string
+	) throws -> Void {
+		let res = api.enableUploadDeduplication(indexPath)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+	}
+	
+	/// Disables skipping of duplicate uploads and forgets the in-memory index.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the index could not be disabled.
+	public func disableUploadDeduplication(
+	) throws -> Void {
+		let res = api.disableUploadDeduplication()
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+	}
+	
+	/// Uploads a file from the local filesystem to a Store, deflating its content on the client.
+	///
+	/// The content is compressed in independent frames behind a small header that marks the file as compressed, so it is read back
+	/// transparently once `setTransparentDecompression(enabled:)` is enabled, including seeking to any position.
+	/// Clients without it see the compressed content, and `getFile` reports the compressed size.
+	///
+	/// - Parameters:
+	///   - storeId: The Store in which the file should be created.
+	///   - publicMeta: Public metadata for the file.
+	///   - privateMeta: Private metadata for the file.
+	///   - filePath: Path of the source file.
+	///   - level: zlib compression level from `1` (fastest) to `9` (smallest).
+	///
+	/// - Throws: `PrivMXEndpointError.failedWritingToFile` if the upload fails.
+	///
+	/// - Returns: The Id of the created file.
+	public func uploadFileCompressed(
+		storeId: std.string,
+		publicMeta: privmx.endpoint.core.Buffer,
+		privateMeta: privmx.endpoint.core.Buffer,
+		filePath: std.string,
+		level: Int64 = 6
+	) throws -> std.string {
+		let res = api.uploadFileCompressed(storeId, publicMeta, privateMeta, filePath, level)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.failedWritingToFile(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.failedWritingToFile(err)
+		}
+		return result
+	}
+	
+	/// Enables reading files uploaded by `uploadFileCompressed` as their original content.
+	///
+	/// Applies to `openFile`, `readRange` and `downloadFileToPath`. Reading a compressed file inflates only the frames covering the requested range.
+	///
+	/// - Parameter enabled: Whether compressed files are decompressed on read.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the setting could not be applied.
+	public func setTransparentDecompression(
+		enabled: Bool
+	) throws -> Void {
+		let res = api.setTransparentDecompression(enabled)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+	}
 	
+	/// Uploads a file from the local filesystem to a Store.
+	///
+	/// The file is created, written and closed natively. The source is memory-mapped, so the resident memory does not grow with the file size.
+	///
+	/// - Parameters:
+	///   - storeId: The Store in which the file should be created.
+	///   - publicMeta: Public metadata for the file.
+	///   - privateMeta: Private metadata for the file.
+	///   - filePath: Path of the source file.
+	///
+	/// - Throws: `PrivMXEndpointError.failedWritingToFile` if the upload fails.
+	///
+	/// - Returns: The ID of the created file as a `std.string`.
+	public func uploadFile(
+		storeId: std.string,
+		publicMeta: privmx.endpoint.core.Buffer,
+		privateMeta: privmx.endpoint.core.Buffer,
+		filePath: std.string
+	) throws -> std.string {
+		let res = api.uploadFile(storeId, publicMeta, privateMeta, filePath)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.failedWritingToFile(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.failedWritingToFile(err)
+		}
+		return result
+	}
+
+	/// Uploads a file to a Store, pulling its content from a closure.
+	///
+	/// The `reader` is called on a background thread with a buffer to fill and returns the number of bytes written to it, or `0` when there is no more data.
+	/// Producing the next chunk overlaps with encrypting and sending the previous one.
+	///
+	/// - Parameters:
+	///   - storeId: The Store in which the file should be created.
+	///   - publicMeta: Public metadata for the file.
+	///   - privateMeta: Private metadata for the file.
+	///   - size: The size of the file in bytes.
+	///   - reader: Supplies consecutive parts of the file.
+	///
+	/// - Throws: `PrivMXEndpointError.failedWritingToFile` if the upload fails.
+	///
+	/// - Returns: The ID of the created file as a `std.string`.
+	public func uploadFile(
+		storeId: std.string,
+		publicMeta: privmx.endpoint.core.Buffer,
+		privateMeta: privmx.endpoint.core.Buffer,
+		size: Int64,
+		reader: @escaping (UnsafeMutableRawBufferPointer) -> Int
+	) throws -> std.string {
+		let box = Unmanaged.passRetained(ChunkReaderBox(reader))
+		defer { box.release() }
+		let res = api.uploadFile(storeId, publicMeta, privateMeta, size, { context, buffer, capacity in
+			let reader = Unmanaged<ChunkReaderBox>.fromOpaque(context!).takeUnretainedValue()
+			return Int64(reader.read(UnsafeMutableRawBufferPointer(start: buffer, count: Int(capacity))))
+		}, box.toOpaque())
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.failedWritingToFile(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.failedWritingToFile(err)
+		}
+		return result
+	}
+
 	/// Subscribes to Store-related events.
     ///
     /// - Throws: `PrivMXEndpointError.failedSubscribingForEvents` if subscribing to Store events fails.
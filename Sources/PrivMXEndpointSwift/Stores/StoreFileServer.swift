@@ -0,0 +1,112 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+import Foundation
+import Cxx
+import CxxStdlib
+import PrivMXEndpointSwiftNative
+
+/// Swift wrapper for `privmx.NativeStoreFileServer`, an HTTP server on the loopback interface that streams decrypted Store files to media players.
+///
+/// The server supports `Range` requests and persistent connections. It is stopped when `stop()` is called or the instance is released.
+public class StoreFileServer{
+	
+	/// An instance of the wrapped C++ class.
+	internal var api: privmx.NativeStoreFileServer
+	
+	/// Starts a new server reading files through the provided `StoreApi`.
+	///
+	/// - Parameters:
+	///   - storeApi: The Store API instance used to read the files.
+	///   - port: The loopback port to listen on, `0` (the default) picks a free one.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the server cannot be started.
+	///
+	/// - Returns: A running `StoreFileServer` instance.
+	public static func create(
+		storeApi: inout StoreApi,
+		port: Int64 = 0
+	) throws -> StoreFileServer {
+		let res = privmx.NativeStoreFileServer.create(&storeApi.api, port)
+		guard res.error.value == nil else{
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+		guard let result = res.result.value else{
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.otherFailure(err)
+		}
+		return StoreFileServer(api: result)
+	}
+	
+	private init(
+		api: privmx.NativeStoreFileServer
+	){
+		self.api = api
+	}
+	
+	/// Gets the port the server listens on.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the port cannot be read.
+	///
+	/// - Returns: The port number.
+	public func getPort(
+	) throws -> Int64 {
+		let res = api.getPort()
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.otherFailure(err)
+		}
+		return result
+	}
+	
+	/// Gets the URL under which a file is served.
+	///
+	/// Append `&type=` with a MIME type to set the `Content-Type` of the responses, which some players rely on.
+	///
+	/// - Parameter fileId: The unique identifier of the file.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the server has been stopped.
+	///
+	/// - Returns: The URL as a `std.string`.
+	public func getFileUrl(
+		fileId: std.string
+	) throws -> std.string {
+		let res = api.getFileUrl(fileId)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.otherFailure(err)
+		}
+		return result
+	}
+	
+	/// Stops the server and aborts the ongoing responses.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the server cannot be stopped.
+	public func stop(
+	) throws -> Void {
+		let res = api.stop()
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+	}
+}
@@ -0,0 +1,230 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+import Foundation
+import Cxx
+import CxxStdlib
+import PrivMXEndpointSwiftNative
+
+/// Swift wrapper for `privmx.NativeStoreTransferManager`, queueing Store file uploads and downloads on a pool of native worker threads.
+///
+/// Jobs with a higher priority start first. Once the manager is released, queued jobs are cancelled and running ones are awaited.
+public class StoreTransferManager{
+	
+	/// An instance of the wrapped C++ class.
+	internal var api: privmx.NativeStoreTransferManager
+	
+	/// Creates a new instance of `StoreTransferManager` performing transfers through the provided `StoreApi`.
+	///
+	/// - Parameters:
+	///   - storeApi: The Store API instance used for the transfers.
+	///   - concurrencyLimit: Maximum number of transfers running at the same time.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the initialization fails.
+	///
+	/// - Returns: A newly created `StoreTransferManager` instance.
+	public static func create(
+		storeApi: inout StoreApi,
+		concurrencyLimit: Int64
+	) throws -> StoreTransferManager {
+		let res = privmx.NativeStoreTransferManager.create(&storeApi.api, concurrencyLimit)
+		guard res.error.value == nil else{
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+		guard let result = res.result.value else{
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.otherFailure(err)
+		}
+		return StoreTransferManager(api: result)
+	}
+	
+	private init(
+		api: privmx.NativeStoreTransferManager
+	){
+		self.api = api
+	}
+	
+	/// Queues an upload of a local file to a Store.
+	///
+	/// - Parameters:
+	///   - storeId: The Store in which the file should be created.
+	///   - publicMeta: Public metadata for the file.
+	///   - privateMeta: Private metadata for the file.
+	///   - filePath: Path of the source file.
+	///   - priority: Jobs with a higher value start first.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the job cannot be queued.
+	///
+	/// - Returns: The ID of the job.
+	public func enqueueUpload(
+		storeId: std.string,
+		publicMeta: privmx.endpoint.core.Buffer,
+		privateMeta: privmx.endpoint.core.Buffer,
+		filePath: std.string,
+		priority: Int64 = 0
+	) throws -> Int64 {
+		let res = api.enqueueUpload(storeId, publicMeta, privateMeta, filePath, priority)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.otherFailure(err)
+		}
+		return result
+	}
+	
+	/// Queues a download of a Store file to the local filesystem.
+	///
+	/// - Parameters:
+	///   - fileId: The unique identifier of the file to download.
+	///   - filePath: Path of the target file, overwritten if it exists.
+	///   - priority: Jobs with a higher value start first.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the job cannot be queued.
+	///
+	/// - Returns: The ID of the job.
+	public func enqueueDownload(
+		fileId: std.string,
+		filePath: std.string,
+		priority: Int64 = 0
+	) throws -> Int64 {
+		let res = api.enqueueDownload(fileId, filePath, priority)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.otherFailure(err)
+		}
+		return result
+	}
+	
+	/// Changes the maximum number of transfers running at the same time. Running transfers are never interrupted.
+	///
+	/// - Parameter concurrencyLimit: The new limit, must be positive.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the limit is invalid.
+	public func setConcurrencyLimit(
+		_ concurrencyLimit: Int64
+	) throws -> Void {
+		let res = api.setConcurrencyLimit(concurrencyLimit)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+	}
+	
+	/// Cancels a job that has not started yet.
+	///
+	/// - Parameter jobId: The ID of the job.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the job is unknown.
+	///
+	/// - Returns: `true` if the job was cancelled, `false` if it is already running or finished.
+	public func cancelJob(
+		_ jobId: Int64
+	) throws -> Bool {
+		let res = api.cancelJob(jobId)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.otherFailure(err)
+		}
+		return result
+	}
+	
+	/// Gets the current status of a job.
+	///
+	/// - Parameter jobId: The ID of the job.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the job is unknown.
+	///
+	/// - Returns: A `privmx.TransferJobStatus` snapshot.
+	public func getJobStatus(
+		_ jobId: Int64
+	) throws -> privmx.TransferJobStatus {
+		let res = api.getJobStatus(jobId)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.otherFailure(err)
+		}
+		return result
+	}
+	
+	/// Blocks the calling thread until a job is finished.
+	///
+	/// - Parameter jobId: The ID of the job.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the job is unknown.
+	///
+	/// - Returns: The final `privmx.TransferJobStatus` of the job.
+	public func waitForJob(
+		_ jobId: Int64
+	) throws -> privmx.TransferJobStatus {
+		let res = api.waitForJob(jobId)
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.otherFailure(err)
+		}
+		return result
+	}
+	
+	/// Gets the aggregate counters and throughput of all jobs.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the counters cannot be read.
+	///
+	/// - Returns: A `privmx.TransferStats` snapshot.
+	public func getStats(
+	) throws -> privmx.TransferStats {
+		let res = api.getStats()
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.otherFailure(err)
+		}
+		return result
+	}
+	
+	/// Drops the statuses of finished jobs, which are otherwise kept for the lifetime of the manager.
+	///
+	/// - Throws: `PrivMXEndpointError.otherFailure` if the statuses cannot be dropped.
+	public func forgetFinishedJobs(
+	) throws -> Void {
+		let res = api.forgetFinishedJobs()
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.otherFailure(res.error.value!)
+		}
+	}
+}
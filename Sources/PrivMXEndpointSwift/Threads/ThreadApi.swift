@@ -252,6 +252,45 @@ public class ThreadApi{
 		return result
 	}
 	
+	/// Sends a message in a Thread, passing the provided memory without copying it into `Buffer`s first.
+	///
+	/// - Parameters:
+	///   - threadId: The unique identifier of the Thread to send the message to.
+	///   - publicMeta: Public metadata for the message, which will not be encrypted.
+	///   - privateMeta: Encrypted metadata for the message.
+	///   - data: The actual content of the message.
+	///
+	/// - Throws: `PrivMXEndpointError.failedCreatingMessage` if the message creation fails.
+	///
+	/// - Returns: The ID of the created message as a `std.string`.
+	public func sendMessage(
+		threadId: std.string,
+		publicMeta: Data,
+		privateMeta: Data,
+		data: Data
+	) throws -> std.string{
+		let res = publicMeta.withUnsafeBytes { pub in
+			privateMeta.withUnsafeBytes { priv in
+				data.withUnsafeBytes { content in
+					api.sendMessage(threadId,
+									privmx.makeBufferView(pub.baseAddress, pub.count),
+									privmx.makeBufferView(priv.baseAddress, priv.count),
+									privmx.makeBufferView(content.baseAddress, content.count))
+				}
+			}
+		}
+		guard res.error.value == nil else {
+			throw PrivMXEndpointError.failedCreatingMessage(res.error.value!)
+		}
+		guard let result = res.result.value else {
+			var err = privmx.InternalError()
+			err.name = "Value error"
+			err.description = "Unexpectedly received nil result"
+			throw PrivMXEndpointError.failedCreatingMessage(err)
+		}
+		return result
+	}
+	
 	/// Deletes a specified message.
 	///
 	/// - Parameter messageId: The unique identifier of the message to delete.
@@ -0,0 +1,95 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "AsyncFileWriter.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+namespace privmx {
+namespace transfer {
+
+AsyncFileWriter::~AsyncFileWriter(){
+	std::vector<std::shared_ptr<Writer>> pending;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		for(auto& [handle, writer] : writers) pending.push_back(writer);
+		writers.clear();
+	}
+	for(auto& writer : pending) finish(*writer);
+}
+
+void AsyncFileWriter::setEnabled(bool enabled){
+	on = enabled;
+}
+
+void AsyncFileWriter::submit(int64_t handle, MemoryReservation reservation, std::function<void()> write){
+	std::shared_ptr<Writer> writer;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto& entry = writers[handle];
+		if(!entry){
+			entry = std::make_shared<Writer>();
+			Writer& created = *entry;
+			entry->worker = std::thread([&created]{ run(created); });
+		}
+		writer = entry;
+	}
+	{
+		std::lock_guard<std::mutex> lock(writer->mutex);
+		if(writer->error) std::rethrow_exception(writer->error);
+	}
+	if(!writer->queue.push(Task{std::move(write), std::move(reservation)})){
+		// The worker stopped on a failed write while the caller was waiting for room in the queue.
+		std::lock_guard<std::mutex> lock(writer->mutex);
+		if(writer->error) std::rethrow_exception(writer->error);
+		throw std::logic_error("The handle was flushed while being written");
+	}
+}
+
+void AsyncFileWriter::flush(int64_t handle){
+	std::shared_ptr<Writer> writer;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto it = writers.find(handle);
+		if(it == writers.end()) return;
+		writer = it->second;
+		writers.erase(it);
+	}
+	finish(*writer);
+	std::lock_guard<std::mutex> lock(writer->mutex);
+	if(writer->error) std::rethrow_exception(writer->error);
+}
+
+void AsyncFileWriter::run(Writer& writer){
+	while(auto task = writer.queue.pop()){
+		try{
+			task->write();
+		}catch(...){
+			{
+				std::lock_guard<std::mutex> lock(writer.mutex);
+				writer.error = std::current_exception();
+			}
+			// Later chunks would leave a gap in the content, drop them and release their memory.
+			writer.queue.close();
+			while(writer.queue.pop());
+			return;
+		}
+	}
+}
+
+void AsyncFileWriter::finish(Writer& writer){
+	writer.queue.close();
+	if(writer.worker.joinable()) writer.worker.join();
+}
+
+}
+}
@@ -0,0 +1,85 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef _PRIVMX_ENDPOINT_SWIFT_NATIVE_AsyncFileWriter_hpp
+#define _PRIVMX_ENDPOINT_SWIFT_NATIVE_AsyncFileWriter_hpp
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "FileTransferUtils.hpp"
+#include "TransferMemoryBudget.hpp"
+
+namespace privmx {
+namespace transfer {
+
+/// Number of chunks that may wait for the writer of a handle while another one is being written.
+constexpr size_t ASYNC_WRITE_QUEUE_DEPTH = 1;
+
+/**
+ * Runs the writes of file handles on background threads, one per handle, so the caller can prepare the next chunk
+ * while the previous one is encrypted and sent.
+ *
+ * Writes of a handle run in the order they were submitted. The first failed write stops the writer of its handle:
+ * the remaining queued writes are dropped and the error is rethrown by every later `submit()` and by `flush()`.
+ * Shared by all copies of a wrapper, pending writes are awaited when the last copy is destroyed.
+ */
+class AsyncFileWriter{
+public:
+	AsyncFileWriter() = default;
+	~AsyncFileWriter();
+	AsyncFileWriter(const AsyncFileWriter&) = delete;
+	AsyncFileWriter& operator=(const AsyncFileWriter&) = delete;
+
+	/// Turns the asynchronous mode on or off. Handles with queued writes keep their writer until flushed.
+	void setEnabled(bool enabled);
+	bool enabled() const { return on; }
+
+	/**
+	 * Queues a write of the handle, blocking while `ASYNC_WRITE_QUEUE_DEPTH` writes are already waiting.
+	 *
+	 * `write` must own the data it writes. The reservation is held until the write has finished.
+	 * Rethrows the error of an earlier failed write of the handle instead of queueing.
+	 */
+	void submit(int64_t handle, MemoryReservation reservation, std::function<void()> write);
+
+	/// Waits for the queued writes of the handle and forgets it. Rethrows the first failed write, does nothing for unknown handles.
+	void flush(int64_t handle);
+
+private:
+	struct Task{
+		std::function<void()> write;
+		MemoryReservation reservation;
+	};
+	struct Writer{
+		BoundedQueue<Task> queue{ASYNC_WRITE_QUEUE_DEPTH};
+		std::thread worker;
+		std::mutex mutex;
+		std::exception_ptr error;
+	};
+
+	static void run(Writer& writer);
+	static void finish(Writer& writer);
+
+	std::atomic<bool> on{false};
+	std::mutex mutex;
+	std::unordered_map<int64_t, std::shared_ptr<Writer>> writers;
+};
+
+}
+}
+
+#endif /* _PRIVMX_ENDPOINT_SWIFT_NATIVE_AsyncFileWriter_hpp */
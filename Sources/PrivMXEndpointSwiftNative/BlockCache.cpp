@@ -0,0 +1,120 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "BlockCache.hpp"
+
+#include <limits>
+#include <stdexcept>
+
+namespace privmx {
+namespace transfer {
+
+BlockCache::BlockCache(){
+	reclaimerId = TransferMemoryBudget::instance().addReclaimer([this](int64_t bytes){ return shrink(bytes); });
+}
+
+BlockCache::~BlockCache(){
+	TransferMemoryBudget::instance().removeReclaimer(reclaimerId);
+}
+
+void BlockCache::setCapacity(int64_t bytes){
+	if(bytes < 0) throw std::invalid_argument("The cache size cannot be negative");
+	std::lock_guard<std::mutex> lock(mutex);
+	capacity = bytes;
+	evict();
+}
+
+bool BlockCache::enabled(){
+	std::lock_guard<std::mutex> lock(mutex);
+	return capacity > 0;
+}
+
+BlockCache::Block BlockCache::get(const std::string& fileId, int64_t blockIndex){
+	std::lock_guard<std::mutex> lock(mutex);
+	auto it = index.find(Key(fileId, blockIndex));
+	if(it == index.end()) return nullptr;
+	entries.splice(entries.begin(), entries, it->second);
+	return it->second->block;
+}
+
+uint64_t BlockCache::generation(){
+	std::lock_guard<std::mutex> lock(mutex);
+	return currentGeneration;
+}
+
+void BlockCache::put(const std::string& fileId, int64_t blockIndex, Block block, uint64_t fetchGeneration){
+	std::lock_guard<std::mutex> lock(mutex);
+	if(capacity == 0 || static_cast<int64_t>(block->size()) > capacity) return;
+	// The block may hold content from before an invalidation that happened while it was fetched.
+	if(fetchGeneration < forgottenGeneration) return;
+	auto invalidated = invalidations.find(fileId);
+	if(invalidated != invalidations.end() && invalidated->second > fetchGeneration) return;
+	Key key(fileId, blockIndex);
+	auto it = index.find(key);
+	if(it != index.end()){
+		size -= it->second->block->size();
+		entries.erase(it->second);
+		index.erase(it);
+	}
+	auto reservation = TransferMemoryBudget::instance().reserveReclaimable(block->size());
+	// Older blocks make room for the new one within the budget, unless a transfer is waiting for the memory.
+	while(!reservation && !entries.empty()){
+		evictLast();
+		reservation = TransferMemoryBudget::instance().reserveReclaimable(block->size());
+	}
+	if(!reservation) return;
+	size += block->size();
+	entries.push_front(Entry{.key = key, .block = std::move(block), .reservation = std::move(*reservation)});
+	index[key] = entries.begin();
+	evict();
+}
+
+void BlockCache::invalidate(const std::string& fileId){
+	std::lock_guard<std::mutex> lock(mutex);
+	++currentGeneration;
+	if(invalidations.size() >= MAX_INVALIDATED_FILES){
+		// Rejects every fetch started before now instead of remembering each file.
+		invalidations.clear();
+		forgottenGeneration = currentGeneration;
+	}
+	invalidations[fileId] = currentGeneration;
+	auto it = index.lower_bound(Key(fileId, std::numeric_limits<int64_t>::min()));
+	while(it != index.end() && it->first.first == fileId){
+		size -= it->second->block->size();
+		entries.erase(it->second);
+		it = index.erase(it);
+	}
+}
+
+void BlockCache::evict(){
+	while(size > capacity && !entries.empty()){
+		evictLast();
+	}
+}
+
+int64_t BlockCache::shrink(int64_t bytes){
+	std::lock_guard<std::mutex> lock(mutex);
+	int64_t freed = 0;
+	while(freed < bytes && !entries.empty()){
+		freed += entries.back().block->size();
+		evictLast();
+	}
+	return freed;
+}
+
+void BlockCache::evictLast(){
+	size -= entries.back().block->size();
+	index.erase(entries.back().key);
+	entries.pop_back();
+}
+
+}
+}
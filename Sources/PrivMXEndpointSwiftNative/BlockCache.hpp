@@ -0,0 +1,96 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef _PRIVMX_ENDPOINT_SWIFT_NATIVE_BlockCache_hpp
+#define _PRIVMX_ENDPOINT_SWIFT_NATIVE_BlockCache_hpp
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "privmx/endpoint/core/Types.hpp"
+#include "TransferMemoryBudget.hpp"
+
+namespace privmx {
+namespace transfer {
+
+/// Size of the file blocks kept by `BlockCache`. Cached reads fetch whole blocks aligned to it.
+constexpr int64_t CACHE_BLOCK_SIZE = 256 * 1024;
+
+/// Number of files whose last invalidation is remembered, older ones are forgotten together when it grows past it.
+constexpr size_t MAX_INVALIDATED_FILES = 1024;
+
+/**
+ * LRU cache of decrypted file blocks, keyed by file ID and block index.
+ *
+ * Keeps at most `capacity` bytes, evicting the least recently used blocks. A capacity of `0` disables caching.
+ * Cached blocks count against the transfer memory budget: a block is only cached when the budget has room for it,
+ * and blocks are evicted when a transfer has to wait for memory.
+ * Blocks are fetched outside the cache, so `put()` takes the generation read before the fetch and drops a block
+ * whose file was invalidated in the meantime.
+ */
+class BlockCache{
+public:
+	using Block = std::shared_ptr<const endpoint::core::Buffer>;
+
+	BlockCache();
+	~BlockCache();
+	BlockCache(const BlockCache&) = delete;
+	BlockCache& operator=(const BlockCache&) = delete;
+
+	void setCapacity(int64_t bytes);
+	bool enabled();
+
+	/// Returns the cached block or `nullptr`, marking a hit as recently used.
+	Block get(const std::string& fileId, int64_t index);
+
+	/// Returns the current generation, to be read before fetching a block and passed to `put()`.
+	uint64_t generation();
+
+	/// Caches a block fetched after `generation()` returned `fetchGeneration`, unless its file has been invalidated since.
+	void put(const std::string& fileId, int64_t index, Block block, uint64_t fetchGeneration);
+
+	/// Drops all blocks of a file whose content has changed and rejects blocks of it still being fetched.
+	void invalidate(const std::string& fileId);
+
+private:
+	using Key = std::pair<std::string, int64_t>;
+	struct Entry{
+		Key key;
+		Block block;
+		MemoryReservation reservation;
+	};
+
+	void evict();
+	/// Evicts the least recently used blocks until `bytes` have been freed or the cache is empty, returns the amount freed.
+	int64_t shrink(int64_t bytes);
+	void evictLast();
+
+	std::mutex mutex;
+	int64_t capacity = 0;
+	int64_t size = 0;
+	std::list<Entry> entries; ///< Most recently used first
+	std::map<Key, std::list<Entry>::iterator> index;
+	uint64_t currentGeneration = 0;
+	uint64_t forgottenGeneration = 0; ///< Generation at which the invalidations were last forgotten
+	std::unordered_map<std::string, uint64_t> invalidations; ///< Generation of the last invalidation of a file
+	int64_t reclaimerId;
+};
+
+}
+}
+
+#endif /* _PRIVMX_ENDPOINT_SWIFT_NATIVE_BlockCache_hpp */
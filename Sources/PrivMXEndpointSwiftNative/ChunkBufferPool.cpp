@@ -0,0 +1,149 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "ChunkBufferPool.hpp"
+
+#include <stdexcept>
+
+namespace privmx {
+namespace transfer {
+
+PooledBuffer::PooledBuffer(std::unique_ptr<char[]> block, size_t blockSize, size_t length) :
+	block(std::move(block)),
+	blockSize(blockSize),
+	length(length)
+{}
+
+PooledBuffer::~PooledBuffer(){
+	recycle();
+}
+
+PooledBuffer::PooledBuffer(PooledBuffer&& other) noexcept :
+	block(std::move(other.block)),
+	blockSize(other.blockSize),
+	length(other.length)
+{
+	other.blockSize = 0;
+	other.length = 0;
+}
+
+PooledBuffer& PooledBuffer::operator=(PooledBuffer&& other) noexcept{
+	if(this != &other){
+		recycle();
+		block = std::move(other.block);
+		blockSize = other.blockSize;
+		length = other.length;
+		other.blockSize = 0;
+		other.length = 0;
+	}
+	return *this;
+}
+
+void PooledBuffer::resize(size_t size){
+	if(size > blockSize) throw std::length_error("A pooled buffer cannot grow past its capacity");
+	length = size;
+}
+
+void PooledBuffer::recycle(){
+	if(block) ChunkBufferPool::instance().recycle(std::move(block), blockSize);
+	blockSize = 0;
+	length = 0;
+}
+
+ChunkBufferPool& ChunkBufferPool::instance(){
+	static ChunkBufferPool pool;
+	return pool;
+}
+
+ChunkBufferPool::ChunkBufferPool(){
+	size_t classes = 1;
+	for(size_t size = MIN_POOLED_CHUNK_SIZE; size < MAX_POOLED_CHUNK_SIZE; size <<= 1){
+		classes++;
+	}
+	idle.resize(classes);
+}
+
+size_t ChunkBufferPool::sizeClass(size_t size){
+	size_t index = 0;
+	for(size_t classSize = MIN_POOLED_CHUNK_SIZE; classSize < size; classSize <<= 1){
+		index++;
+	}
+	return index;
+}
+
+PooledBuffer ChunkBufferPool::acquire(size_t size){
+	if(size > MAX_POOLED_CHUNK_SIZE){
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			heapAllocations++;
+		}
+		return PooledBuffer(std::unique_ptr<char[]>(new char[size]), size, size);
+	}
+	size_t index = sizeClass(size);
+	size_t blockSize = MIN_POOLED_CHUNK_SIZE << index;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto& blocks = idle[index];
+		if(!blocks.empty()){
+			std::unique_ptr<char[]> block = std::move(blocks.back());
+			blocks.pop_back();
+			idleBytes -= blockSize;
+			reusedBuffers++;
+			return PooledBuffer(std::move(block), blockSize, size);
+		}
+		heapAllocations++;
+	}
+	// Not value-initialised, the contents are always overwritten before use.
+	return PooledBuffer(std::unique_ptr<char[]>(new char[blockSize]), blockSize, size);
+}
+
+endpoint::core::Buffer ChunkBufferPool::copyToBuffer(const char* data, size_t size){
+	if(size > 0){
+		std::lock_guard<std::mutex> lock(mutex);
+		heapAllocations++;
+	}
+	return endpoint::core::Buffer::from(data, size);
+}
+
+void ChunkBufferPool::recycle(std::unique_ptr<char[]> block, size_t blockSize){
+	if(blockSize > MAX_POOLED_CHUNK_SIZE) return;
+	std::lock_guard<std::mutex> lock(mutex);
+	auto& blocks = idle[sizeClass(blockSize)];
+	if(blocks.size() >= MAX_IDLE_BLOCKS_PER_CLASS) return;
+	blocks.push_back(std::move(block));
+	idleBytes += blockSize;
+}
+
+TransferBufferPoolStats ChunkBufferPool::stats(){
+	std::lock_guard<std::mutex> lock(mutex);
+	int64_t idleBuffers = 0;
+	for(const auto& blocks : idle){
+		idleBuffers += blocks.size();
+	}
+	return TransferBufferPoolStats{
+		.heapAllocations = heapAllocations,
+		.reusedBuffers = reusedBuffers,
+		.idleBuffers = idleBuffers,
+		.idleBytes = idleBytes
+	};
+}
+
+void ChunkBufferPool::trim(){
+	std::vector<std::vector<std::unique_ptr<char[]>>> released(idle.size());
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		idle.swap(released);
+		idleBytes = 0;
+	}
+}
+
+}
+}
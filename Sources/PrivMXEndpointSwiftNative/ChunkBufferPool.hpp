@@ -0,0 +1,107 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef _PRIVMX_ENDPOINT_SWIFT_NATIVE_ChunkBufferPool_hpp
+#define _PRIVMX_ENDPOINT_SWIFT_NATIVE_ChunkBufferPool_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "privmx/endpoint/core/Types.hpp"
+#include "NativeTransferConfig.hpp"
+
+namespace privmx {
+namespace transfer {
+
+/// Smallest size class of the pool, smaller requests are rounded up to it.
+constexpr size_t MIN_POOLED_CHUNK_SIZE = 64 * 1024;
+
+/// Largest size class of the pool, larger requests are served straight from the heap.
+constexpr size_t MAX_POOLED_CHUNK_SIZE = 16 * 1024 * 1024;
+
+/// Number of idle blocks kept per size class.
+constexpr size_t MAX_IDLE_BLOCKS_PER_CLASS = 4;
+
+class ChunkBufferPool;
+
+/**
+ * Staging buffer of a transfer chunk, handed back to the pool on destruction.
+ */
+class PooledBuffer{
+public:
+	PooledBuffer() = default;
+	~PooledBuffer();
+	PooledBuffer(PooledBuffer&& other) noexcept;
+	PooledBuffer& operator=(PooledBuffer&& other) noexcept;
+	PooledBuffer(const PooledBuffer&) = delete;
+	PooledBuffer& operator=(const PooledBuffer&) = delete;
+
+	char* data() { return block.get(); }
+	const char* data() const { return block.get(); }
+	size_t size() const { return length; }
+	size_t capacity() const { return blockSize; }
+
+	/// Changes the used length, which cannot exceed the capacity.
+	void resize(size_t size);
+
+private:
+	friend class ChunkBufferPool;
+	PooledBuffer(std::unique_ptr<char[]> block, size_t blockSize, size_t length);
+	void recycle();
+
+	std::unique_ptr<char[]> block;
+	size_t blockSize = 0;
+	size_t length = 0;
+};
+
+/**
+ * Process-wide pool of chunk staging buffers, grouped in power-of-two size classes.
+ *
+ * Transfers that move chunks of a steady size reuse the same staging blocks. The Api only takes and returns buffers owning
+ * their storage, so every chunk crossing it is still copied into a fresh allocation, see `copyToBuffer()`.
+ */
+class ChunkBufferPool{
+public:
+	static ChunkBufferPool& instance();
+
+	/// Returns a buffer of `size` bytes, reusing an idle block of the matching size class if there is one.
+	PooledBuffer acquire(size_t size);
+
+	/// Copies a chunk into a buffer passed to the Api or returned to Swift, counting its allocation in the stats.
+	endpoint::core::Buffer copyToBuffer(const char* data, size_t size);
+
+	TransferBufferPoolStats stats();
+
+	/// Frees all idle blocks.
+	void trim();
+
+private:
+	friend class PooledBuffer;
+	ChunkBufferPool();
+
+	static size_t sizeClass(size_t size);
+	void recycle(std::unique_ptr<char[]> block, size_t blockSize);
+
+	std::mutex mutex;
+	/// Idle blocks, indexed by the binary logarithm of the block size relative to `MIN_POOLED_CHUNK_SIZE`.
+	std::vector<std::vector<std::unique_ptr<char[]>>> idle;
+	int64_t heapAllocations = 0;
+	int64_t reusedBuffers = 0;
+	int64_t idleBytes = 0;
+};
+
+}
+}
+
+#endif /* _PRIVMX_ENDPOINT_SWIFT_NATIVE_ChunkBufferPool_hpp */
@@ -0,0 +1,138 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "ChunkSizeTuner.hpp"
+#include "FileTransferUtils.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace privmx {
+namespace transfer {
+
+/// Throughput change smaller than this is treated as noise.
+constexpr double THROUGHPUT_TOLERANCE = 0.1;
+
+ChunkSizeTuner& ChunkSizeTuner::uploads(){
+	static ChunkSizeTuner tuner;
+	return tuner;
+}
+
+ChunkSizeTuner& ChunkSizeTuner::downloads(){
+	static ChunkSizeTuner tuner;
+	return tuner;
+}
+
+void ChunkSizeTuner::configure(bool enabled, int64_t minChunkSize, int64_t maxChunkSize){
+	if(minChunkSize <= 0 || maxChunkSize < minChunkSize){
+		throw std::invalid_argument("The chunk size bounds must be positive and the minimum cannot exceed the maximum");
+	}
+	uploads().reset(enabled, minChunkSize, maxChunkSize);
+	downloads().reset(enabled, minChunkSize, maxChunkSize);
+}
+
+TransferChunkStats ChunkSizeTuner::stats(){
+	TransferChunkStats result;
+	{
+		ChunkSizeTuner& tuner = uploads();
+		std::lock_guard<std::mutex> lock(tuner.mutex);
+		result.tuning = tuner.enabled;
+		result.minChunkSize = tuner.minSize;
+		result.maxChunkSize = tuner.maxSize;
+		result.uploadChunkSize = tuner.enabled ? tuner.size : DEFAULT_CHUNK_SIZE;
+		result.uploadBytesPerSecond = tuner.lastThroughput;
+		result.uploadSamples = tuner.totalSamples;
+	}
+	{
+		ChunkSizeTuner& tuner = downloads();
+		std::lock_guard<std::mutex> lock(tuner.mutex);
+		result.downloadChunkSize = tuner.enabled ? tuner.size : DEFAULT_CHUNK_SIZE;
+		result.downloadBytesPerSecond = tuner.lastThroughput;
+		result.downloadSamples = tuner.totalSamples;
+	}
+	return result;
+}
+
+void ChunkSizeTuner::reset(bool enabled, int64_t minChunkSize, int64_t maxChunkSize){
+	std::lock_guard<std::mutex> lock(mutex);
+	this->enabled = enabled;
+	minSize = minChunkSize;
+	maxSize = maxChunkSize;
+	size = minChunkSize;
+	threshold = maxChunkSize;
+	previousSize = 0;
+	previousThroughput = 0;
+	lastThroughput = 0;
+	throughput = 0;
+	samples = 0;
+	settledSteps = 0;
+	totalSamples = 0;
+}
+
+int64_t ChunkSizeTuner::chunkSize(){
+	std::lock_guard<std::mutex> lock(mutex);
+	return enabled ? size : DEFAULT_CHUNK_SIZE;
+}
+
+void ChunkSizeTuner::measure(int64_t requested, const std::function<int64_t()>& transfer){
+	auto started = std::chrono::steady_clock::now();
+	int64_t bytes = transfer();
+	record(requested, bytes, std::chrono::steady_clock::now() - started);
+}
+
+void ChunkSizeTuner::record(int64_t requested, int64_t bytes, std::chrono::steady_clock::duration elapsed){
+	std::lock_guard<std::mutex> lock(mutex);
+	if(!enabled || requested != size || bytes < requested) return;
+	totalSamples++;
+	if(elapsed > TARGET_CHUNK_LATENCY && size > minSize){
+		threshold = std::max(minSize, size / 2);
+		step(threshold);
+		previousSize = 0;
+		previousThroughput = 0;
+		return;
+	}
+	double seconds = std::max(std::chrono::duration<double>(elapsed).count(), 1e-6);
+	throughput += (bytes / seconds - throughput) / ++samples;
+	if(samples < CHUNK_SAMPLES_PER_STEP) return;
+	double measured = throughput;
+	lastThroughput = measured;
+	if(previousSize > 0 && measured < previousThroughput * (1 - THROUGHPUT_TOLERANCE)){
+		// Larger chunks stopped paying off, settle at the previous size.
+		threshold = previousSize;
+		step(previousSize);
+		previousSize = 0;
+		return;
+	}
+	int64_t next = size;
+	if(size < threshold){
+		next = size * 2;
+	}else if(++settledSteps >= STEPS_BEFORE_PROBE){
+		// The link may have improved since the tuner settled.
+		settledSteps = 0;
+		next = size * 2;
+	}
+	samples = 0;
+	throughput = 0;
+	if(next > maxSize || next == size) return;
+	previousSize = size;
+	previousThroughput = measured;
+	step(next);
+}
+
+void ChunkSizeTuner::step(int64_t next){
+	size = next;
+	samples = 0;
+	throughput = 0;
+	settledSteps = 0;
+}
+
+}
+}
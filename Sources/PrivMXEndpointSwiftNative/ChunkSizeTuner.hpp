@@ -0,0 +1,91 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef _PRIVMX_ENDPOINT_SWIFT_NATIVE_ChunkSizeTuner_hpp
+#define _PRIVMX_ENDPOINT_SWIFT_NATIVE_ChunkSizeTuner_hpp
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+#include "NativeTransferConfig.hpp"
+
+namespace privmx {
+namespace transfer {
+
+/// Default lower bound of tuned chunk sizes.
+constexpr int64_t DEFAULT_MIN_TUNED_CHUNK_SIZE = 256 * 1024;
+/// Default upper bound of tuned chunk sizes.
+constexpr int64_t DEFAULT_MAX_TUNED_CHUNK_SIZE = 8 * 1024 * 1024;
+/// A chunk taking longer than this to transfer halves the chunk size, so progress stays responsive on slow links.
+constexpr std::chrono::milliseconds TARGET_CHUNK_LATENCY{2000};
+/// Number of full chunks measured before the chunk size is changed.
+constexpr int CHUNK_SAMPLES_PER_STEP = 3;
+/// Number of steps spent at a settled chunk size before a larger one is tried again.
+constexpr int STEPS_BEFORE_PROBE = 8;
+
+/**
+ * Adapts the chunk size of one direction of file transfers to the measured throughput, in the style of TCP slow start.
+ *
+ * Starts at the lower bound and doubles the size while the throughput keeps growing. A drop in throughput
+ * goes back to the previous size and settles there, probing the larger size again after a while.
+ * A chunk slower than `TARGET_CHUNK_LATENCY` halves the size at once. Sizes stay powers of two times the lower bound,
+ * so tuned chunks keep reusing the size classes of `ChunkBufferPool`.
+ */
+class ChunkSizeTuner{
+public:
+	static ChunkSizeTuner& uploads();
+	static ChunkSizeTuner& downloads();
+
+	/// Enables or disables tuning of both directions. While disabled, `chunkSize()` returns `DEFAULT_CHUNK_SIZE`.
+	static void configure(bool enabled, int64_t minChunkSize, int64_t maxChunkSize);
+
+	/// Returns the settings and the state of both directions.
+	static TransferChunkStats stats();
+
+	/// Size of the next chunk to transfer.
+	int64_t chunkSize();
+
+	/**
+	 * Runs the transfer of a single chunk of `requested` bytes and learns from its duration.
+	 *
+	 * `transfer` returns the number of bytes moved. Chunks shorter than requested and chunks
+	 * of a size other than the current one (e.g. the tail of a file) are not taken into account.
+	 */
+	void measure(int64_t requested, const std::function<int64_t()>& transfer);
+
+private:
+	ChunkSizeTuner() = default;
+
+	void reset(bool enabled, int64_t minChunkSize, int64_t maxChunkSize);
+	void record(int64_t requested, int64_t bytes, std::chrono::steady_clock::duration elapsed);
+	void step(int64_t size);
+
+	std::mutex mutex;
+	bool enabled = false;
+	int64_t minSize = DEFAULT_MIN_TUNED_CHUNK_SIZE;
+	int64_t maxSize = DEFAULT_MAX_TUNED_CHUNK_SIZE;
+	int64_t size = DEFAULT_MIN_TUNED_CHUNK_SIZE;
+	int64_t threshold = DEFAULT_MAX_TUNED_CHUNK_SIZE; ///< Size above which the tuner stopped doubling
+	int64_t previousSize = 0;
+	double previousThroughput = 0; ///< Throughput at `previousSize`, which a larger size has to keep up with
+	double lastThroughput = 0; ///< Throughput of the last completed step, reported in the stats
+	double throughput = 0; ///< Average throughput of the samples at the current size, in bytes per second
+	int samples = 0;
+	int settledSteps = 0;
+	int64_t totalSamples = 0;
+};
+
+}
+}
+
+#endif /* _PRIVMX_ENDPOINT_SWIFT_NATIVE_ChunkSizeTuner_hpp */
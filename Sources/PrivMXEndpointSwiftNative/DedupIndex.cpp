@@ -0,0 +1,160 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "DedupIndex.hpp"
+#include "FileTransferUtils.hpp"
+#include "Sha256Digest.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+
+namespace privmx {
+namespace transfer {
+
+namespace {
+
+// Entries of the first version carry no verifier, such a file is treated as foreign and replaced.
+const char* const INDEX_HEADER = "privmx-dedup-index 2";
+
+}
+
+std::string DedupIndex::verifierOf(const char* data, size_t size){
+	Sha256Digest digest;
+	digest.update(data, std::min<size_t>(size, DEDUP_VERIFIED_PREFIX));
+	return digest.hex();
+}
+
+void DedupIndex::enable(const std::string& path){
+	std::lock_guard<std::mutex> lock(mutex);
+	files.clear();
+	keys.clear();
+	verifiers.clear();
+	this->path = path;
+	active = true;
+	if(path.empty()) return;
+	std::ifstream in(path);
+	std::string line;
+	// A missing or foreign file starts an empty index, which replaces it on the first change.
+	if(!in || !std::getline(in, line) || line != INDEX_HEADER) return;
+	while(std::getline(in, line)){
+		std::istringstream fields(line);
+		std::string storeId, sha256, fileId, verifier;
+		if(fields >> storeId >> sha256 >> fileId >> verifier) insert({storeId, sha256}, fileId, verifier);
+	}
+}
+
+void DedupIndex::disable(){
+	std::lock_guard<std::mutex> lock(mutex);
+	active = false;
+	path.clear();
+	files.clear();
+	keys.clear();
+	verifiers.clear();
+}
+
+bool DedupIndex::enabled(){
+	std::lock_guard<std::mutex> lock(mutex);
+	return active;
+}
+
+std::vector<DedupIndex::Entry> DedupIndex::find(const std::string& storeId, const std::string& sha256){
+	std::lock_guard<std::mutex> lock(mutex);
+	auto it = files.find({storeId, sha256});
+	if(it == files.end()) return {};
+	std::vector<Entry> entries;
+	for(auto fileId = it->second.rbegin(); fileId != it->second.rend(); ++fileId){
+		entries.push_back({.fileId = *fileId, .verifier = verifiers.at(*fileId)});
+	}
+	return entries;
+}
+
+void DedupIndex::add(const std::string& storeId, const std::string& sha256, const std::string& fileId, const std::string& verifier){
+	std::lock_guard<std::mutex> lock(mutex);
+	if(!active) return;
+	erase(fileId);
+	insert({storeId, sha256}, fileId, verifier);
+	// Called once the File exists, an entry that was not persisted only costs a future upload.
+	saveQuietly();
+}
+
+void DedupIndex::remove(const std::string& fileId){
+	std::lock_guard<std::mutex> lock(mutex);
+	if(!keys.count(fileId)) return;
+	erase(fileId);
+	saveQuietly();
+}
+
+void DedupIndex::removeStore(const std::string& storeId){
+	std::lock_guard<std::mutex> lock(mutex);
+	auto first = files.lower_bound({storeId, std::string()});
+	auto last = first;
+	while(last != files.end() && last->first.first == storeId){
+		for(const auto& fileId : last->second){
+			keys.erase(fileId);
+			verifiers.erase(fileId);
+		}
+		++last;
+	}
+	if(first == last) return;
+	files.erase(first, last);
+	saveQuietly();
+}
+
+void DedupIndex::insert(const Key& key, const std::string& fileId, const std::string& verifier){
+	files[key].push_back(fileId);
+	keys[fileId] = key;
+	verifiers[fileId] = verifier;
+}
+
+void DedupIndex::erase(const std::string& fileId){
+	auto key = keys.find(fileId);
+	if(key == keys.end()) return;
+	auto entry = files.find(key->second);
+	auto& ids = entry->second;
+	ids.erase(std::remove(ids.begin(), ids.end(), fileId), ids.end());
+	if(ids.empty()) files.erase(entry);
+	keys.erase(key);
+	verifiers.erase(fileId);
+}
+
+void DedupIndex::saveQuietly(){
+	// A lost addition costs a future upload, a lost removal leaves a stale entry, which is verified before it is ever used.
+	try{
+		save();
+	}catch(...){}
+}
+
+void DedupIndex::save(){
+	if(path.empty()) return;
+	std::ostringstream out;
+	out << INDEX_HEADER << "\n";
+	for(const auto& [key, ids] : files){
+		for(const auto& fileId : ids){
+			out << key.first << " " << key.second << " " << fileId << " " << verifiers.at(fileId) << "\n";
+		}
+	}
+	const std::string content = out.str();
+	const std::string tempPath = path + ".tmp";
+	{
+		OutputFile file(tempPath);
+		file.write(content.data(), content.size());
+	}
+	if(std::rename(tempPath.c_str(), path.c_str()) != 0){
+		throw std::system_error(errno, std::generic_category(), "Failed to store the deduplication index at " + path);
+	}
+}
+
+}
+}
@@ -0,0 +1,86 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef _PRIVMX_ENDPOINT_SWIFT_NATIVE_DedupIndex_hpp
+#define _PRIVMX_ENDPOINT_SWIFT_NATIVE_DedupIndex_hpp
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace privmx {
+namespace transfer {
+
+/// Length of the leading part of the content whose digest verifies an index entry before the File is reused.
+constexpr int64_t DEDUP_VERIFIED_PREFIX = 64 * 1024;
+
+/**
+ * Local index of uploaded File content, mapping a Store and the SHA-256 of the content to the Files holding it.
+ *
+ * Disabled until `enable()` is called. When a path is given, the index is loaded from it and rewritten after every change,
+ * so it survives the process. Changes made while no events were received are not reflected in the index, so every entry
+ * keeps a verifier — the digest of the leading `DEDUP_VERIFIED_PREFIX` bytes of the uploaded content — to be compared
+ * with the stored File before it is reused.
+ */
+class DedupIndex{
+public:
+	struct Entry{
+		std::string fileId;
+		std::string verifier;
+	};
+
+	/// Returns the verifier of content starting with `data`, of which `size` bytes are available.
+	static std::string verifierOf(const char* data, size_t size);
+
+	/// Enables the index, loading the entries stored at `path` unless it is empty.
+	void enable(const std::string& path);
+
+	/// Disables the index and forgets its entries. The file at the path given to `enable()` is left in place.
+	void disable();
+
+	bool enabled();
+
+	/// Returns the Files of the Store known to hold content with the given digest, most recently added first.
+	std::vector<Entry> find(const std::string& storeId, const std::string& sha256);
+
+	/// Records an uploaded File. A failure to persist the index is not reported, the File exists regardless.
+	void add(const std::string& storeId, const std::string& sha256, const std::string& fileId, const std::string& verifier);
+
+	/// Forgets a File whose content has changed or which has been deleted.
+	void remove(const std::string& fileId);
+
+	/// Forgets all Files of a deleted Store.
+	void removeStore(const std::string& storeId);
+
+private:
+	using Key = std::pair<std::string, std::string>;
+
+	void insert(const Key& key, const std::string& fileId, const std::string& verifier);
+	void erase(const std::string& fileId);
+	void save();
+	void saveQuietly();
+
+	std::mutex mutex;
+	bool active = false;
+	std::string path;
+	std::map<Key, std::vector<std::string>> files; ///< Most recently added last
+	std::unordered_map<std::string, Key> keys;
+	std::unordered_map<std::string, std::string> verifiers;
+};
+
+}
+}
+
+#endif /* _PRIVMX_ENDPOINT_SWIFT_NATIVE_DedupIndex_hpp */
@@ -0,0 +1,115 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "EventClassification.hpp"
+
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace privmx {
+namespace transfer {
+
+using namespace endpoint;
+
+namespace {
+
+struct Probe{
+	EventType type;
+	bool (*matches)(const core::EventHolder&);
+};
+
+// Frequent events first, the chain only runs once per type name.
+const Probe PROBES[] = {
+	{EventType::ThreadNewMessage, thread::Events::isThreadNewMessageEvent},
+	{EventType::ThreadStatsChanged, thread::Events::isThreadStatsEvent},
+	{EventType::ThreadMessageUpdated, thread::Events::isThreadMessageUpdatedEvent},
+	{EventType::ThreadMessageDeleted, thread::Events::isThreadMessageDeletedEvent},
+	{EventType::ThreadCreated, thread::Events::isThreadCreatedEvent},
+	{EventType::ThreadUpdated, thread::Events::isThreadUpdatedEvent},
+	{EventType::ThreadDeleted, thread::Events::isThreadDeletedEvent},
+	{EventType::StoreFileCreated, store::Events::isStoreFileCreatedEvent},
+	{EventType::StoreFileUpdated, store::Events::isStoreFileUpdatedEvent},
+	{EventType::StoreFileDeleted, store::Events::isStoreFileDeletedEvent},
+	{EventType::StoreStatsChanged, store::Events::isStoreStatsChangedEvent},
+	{EventType::StoreCreated, store::Events::isStoreCreatedEvent},
+	{EventType::StoreUpdated, store::Events::isStoreUpdatedEvent},
+	{EventType::StoreDeleted, store::Events::isStoreDeletedEvent},
+	{EventType::InboxEntryCreated, inbox::Events::isInboxEntryCreatedEvent},
+	{EventType::InboxEntryDeleted, inbox::Events::isInboxEntryDeletedEvent},
+	{EventType::InboxCreated, inbox::Events::isInboxCreatedEvent},
+	{EventType::InboxUpdated, inbox::Events::isInboxUpdatedEvent},
+	{EventType::InboxDeleted, inbox::Events::isInboxDeletedEvent},
+	{EventType::LibBreak, core::Events::isLibBreakEvent},
+	{EventType::LibConnected, core::Events::isLibConnectedEvent},
+	{EventType::LibDisconnected, core::Events::isLibDisconnectedEvent},
+	{EventType::LibPlatformDisconnected, core::Events::isLibPlatformDisconnectedEvent}
+};
+
+std::shared_mutex typesMutex;
+std::unordered_map<std::string, EventType> typesByName;
+
+template<typename T>
+const T& as(const core::EventHolder& event){
+	const T* typed = dynamic_cast<const T*>(event.get().get());
+	if(!typed) throw std::logic_error("The event does not match its classified type");
+	return *typed;
+}
+
+}
+
+EventType classifyEvent(const core::EventHolder& event){
+	const std::string& name = event.type();
+	{
+		std::shared_lock<std::shared_mutex> lock(typesMutex);
+		auto it = typesByName.find(name);
+		if(it != typesByName.end()) return it->second;
+	}
+	EventType type = EventType::Unknown;
+	for(const auto& probe : PROBES){
+		if(probe.matches(event)){
+			type = probe.type;
+			break;
+		}
+	}
+	std::unique_lock<std::shared_mutex> lock(typesMutex);
+	typesByName.emplace(name, type);
+	return type;
+}
+
+std::string eventContainerId(const core::EventHolder& event, EventType type){
+	switch(type){
+		case EventType::ThreadCreated: return as<thread::ThreadCreatedEvent>(event).data.threadId;
+		case EventType::ThreadUpdated: return as<thread::ThreadUpdatedEvent>(event).data.threadId;
+		case EventType::ThreadDeleted: return as<thread::ThreadDeletedEvent>(event).data.threadId;
+		case EventType::ThreadStatsChanged: return as<thread::ThreadStatsChangedEvent>(event).data.threadId;
+		case EventType::ThreadNewMessage: return as<thread::ThreadNewMessageEvent>(event).data.info.threadId;
+		case EventType::ThreadMessageUpdated: return as<thread::ThreadMessageUpdatedEvent>(event).data.info.threadId;
+		case EventType::ThreadMessageDeleted: return as<thread::ThreadMessageDeletedEvent>(event).data.threadId;
+		case EventType::StoreCreated: return as<store::StoreCreatedEvent>(event).data.storeId;
+		case EventType::StoreUpdated: return as<store::StoreUpdatedEvent>(event).data.storeId;
+		case EventType::StoreDeleted: return as<store::StoreDeletedEvent>(event).data.storeId;
+		case EventType::StoreStatsChanged: return as<store::StoreStatsChangedEvent>(event).data.storeId;
+		case EventType::StoreFileCreated: return as<store::StoreFileCreatedEvent>(event).data.info.storeId;
+		case EventType::StoreFileUpdated: return as<store::StoreFileUpdatedEvent>(event).data.info.storeId;
+		case EventType::StoreFileDeleted: return as<store::StoreFileDeletedEvent>(event).data.storeId;
+		case EventType::InboxCreated: return as<inbox::InboxCreatedEvent>(event).data.inboxId;
+		case EventType::InboxUpdated: return as<inbox::InboxUpdatedEvent>(event).data.inboxId;
+		case EventType::InboxDeleted: return as<inbox::InboxDeletedEvent>(event).data.inboxId;
+		case EventType::InboxEntryCreated: return as<inbox::InboxEntryCreatedEvent>(event).data.inboxId;
+		case EventType::InboxEntryDeleted: return as<inbox::InboxEntryDeletedEvent>(event).data.inboxId;
+		default: return std::string();
+	}
+}
+
+}
+}
@@ -0,0 +1,31 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef _PRIVMX_ENDPOINT_SWIFT_NATIVE_EventClassification_hpp
+#define _PRIVMX_ENDPOINT_SWIFT_NATIVE_EventClassification_hpp
+
+#include <string>
+
+#include "NativeEventClassifier.hpp"
+
+namespace privmx {
+namespace transfer {
+
+/// Returns the type of an event, probing the `is*Event()` checks only for the first event of a type name.
+EventType classifyEvent(const endpoint::core::EventHolder& event);
+
+/// Returns the ID of the Thread, Store or Inbox the event concerns, empty for other events.
+std::string eventContainerId(const endpoint::core::EventHolder& event, EventType type);
+
+}
+}
+
+#endif /* _PRIVMX_ENDPOINT_SWIFT_NATIVE_EventClassification_hpp */
@@ -0,0 +1,112 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "EventCoalescer.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace privmx {
+namespace transfer {
+
+using namespace endpoint;
+
+bool isCoalescable(EventType type){
+	switch(type){
+		case EventType::ThreadStatsChanged:
+		case EventType::ThreadUpdated:
+		case EventType::StoreStatsChanged:
+		case EventType::StoreUpdated:
+		case EventType::InboxUpdated:
+			return true;
+		default:
+			return false;
+	}
+}
+
+EventCoalescer& EventCoalescer::instance(){
+	static EventCoalescer coalescer;
+	return coalescer;
+}
+
+void EventCoalescer::setWindow(std::chrono::milliseconds value){
+	std::lock_guard<std::mutex> lock(mutex);
+	window = std::max(value, std::chrono::milliseconds(0));
+	if(window.count() == 0) releaseAll();
+}
+
+bool EventCoalescer::enabled(){
+	std::lock_guard<std::mutex> lock(mutex);
+	return window.count() > 0;
+}
+
+void EventCoalescer::add(core::EventHolder event, EventType type, const std::string& containerId){
+	std::lock_guard<std::mutex> lock(mutex);
+	if(window.count() == 0 || containerId.empty() || !isCoalescable(type)){
+		if(!containerId.empty()) releaseContainer(containerId);
+		ready.push_back(std::move(event));
+		return;
+	}
+	auto key = std::make_pair(containerId, type);
+	auto it = held.find(key);
+	if(it != held.end()){
+		// Keeps the due time and order of the first event, so a steady stream is still handed over once per window.
+		it->second.event = std::move(event);
+		return;
+	}
+	held.emplace(std::move(key), Held{.event = std::move(event), .due = std::chrono::steady_clock::now() + window, .order = nextOrder++});
+}
+
+std::optional<core::EventHolder> EventCoalescer::next(){
+	std::lock_guard<std::mutex> lock(mutex);
+	if(ready.empty() && !held.empty()){
+		auto now = std::chrono::steady_clock::now();
+		auto first = std::min_element(held.begin(), held.end(), [](const auto& a, const auto& b){ return a.second.order < b.second.order; });
+		if(first->second.due <= now){
+			ready.push_back(std::move(first->second.event));
+			held.erase(first);
+		}
+	}
+	if(ready.empty()) return std::nullopt;
+	core::EventHolder event = std::move(ready.front());
+	ready.pop_front();
+	return event;
+}
+
+std::optional<std::chrono::steady_clock::time_point> EventCoalescer::deadline(){
+	std::lock_guard<std::mutex> lock(mutex);
+	if(!ready.empty()) return std::chrono::steady_clock::now();
+	if(held.empty()) return std::nullopt;
+	return std::min_element(held.begin(), held.end(), [](const auto& a, const auto& b){ return a.second.order < b.second.order; })->second.due;
+}
+
+void EventCoalescer::releaseContainer(const std::string& containerId){
+	std::vector<std::map<std::pair<std::string, EventType>, Held>::iterator> released;
+	for(auto it = held.lower_bound(std::make_pair(containerId, EventType::Unknown)); it != held.end() && it->first.first == containerId; ++it){
+		released.push_back(it);
+	}
+	std::sort(released.begin(), released.end(), [](const auto& a, const auto& b){ return a->second.order < b->second.order; });
+	for(auto it : released){
+		ready.push_back(std::move(it->second.event));
+		held.erase(it);
+	}
+}
+
+void EventCoalescer::releaseAll(){
+	std::vector<Held> released;
+	for(auto& entry : held) released.push_back(std::move(entry.second));
+	held.clear();
+	std::sort(released.begin(), released.end(), [](const Held& a, const Held& b){ return a.order < b.order; });
+	for(auto& entry : released) ready.push_back(std::move(entry.event));
+}
+
+}
+}
@@ -0,0 +1,76 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef _PRIVMX_ENDPOINT_SWIFT_NATIVE_EventCoalescer_hpp
+#define _PRIVMX_ENDPOINT_SWIFT_NATIVE_EventCoalescer_hpp
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "NativeEventClassifier.hpp"
+
+namespace privmx {
+namespace transfer {
+
+/// Returns whether only the latest event of the type per container matters: stats events and Thread, Store and Inbox updates.
+bool isCoalescable(EventType type);
+
+/**
+ * Process-wide stage holding back stats and update events, so a burst of them is handed over as the latest one per container.
+ *
+ * The first event of a type and container is held for the window, later ones within it replace it. Any other event of the
+ * container releases the held ones first, so the events of a single container keep their order.
+ */
+class EventCoalescer{
+public:
+	static EventCoalescer& instance();
+
+	/// Sets the window, `0` disables the stage and releases the held events.
+	void setWindow(std::chrono::milliseconds window);
+
+	/// Passes an event through the stage, it is then returned by `next()` at once or when its window ends.
+	void add(endpoint::core::EventHolder event, EventType type, const std::string& containerId);
+
+	/// Returns the next event ready to be handed over.
+	std::optional<endpoint::core::EventHolder> next();
+
+	/// Returns when the earliest held event is due, `nullopt` if none are held.
+	std::optional<std::chrono::steady_clock::time_point> deadline();
+
+	bool enabled();
+
+private:
+	struct Held{
+		endpoint::core::EventHolder event;
+		std::chrono::steady_clock::time_point due;
+		uint64_t order;
+	};
+
+	EventCoalescer() = default;
+	void releaseContainer(const std::string& containerId);
+	void releaseAll();
+
+	std::mutex mutex;
+	std::chrono::milliseconds window{0};
+	uint64_t nextOrder = 0;
+	std::map<std::pair<std::string, EventType>, Held> held;
+	std::deque<endpoint::core::EventHolder> ready;
+};
+
+}
+}
+
+#endif /* _PRIVMX_ENDPOINT_SWIFT_NATIVE_EventCoalescer_hpp */
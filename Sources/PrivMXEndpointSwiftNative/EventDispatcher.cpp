@@ -0,0 +1,176 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "EventDispatcher.hpp"
+#include "EventClassification.hpp"
+#include "EventPipeline.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+
+namespace privmx {
+namespace transfer {
+
+using namespace endpoint;
+
+namespace {
+
+std::atomic<bool> dispatching{false};
+
+void finish(std::thread& thread){
+	if(!thread.joinable()) return;
+	if(thread.get_id() == std::this_thread::get_id()){
+		// Stopped from one of its own callbacks, the thread ends on its own once the callback returns.
+		thread.detach();
+	}else{
+		thread.join();
+	}
+}
+
+}
+
+EventDispatcher::Subscription::~Subscription(){
+	if(release) release(context);
+}
+
+EventDispatcher::Subscriptions EventDispatcher::Core::match(EventType type, const std::string& containerId){
+	Subscriptions matched;
+	std::lock_guard<std::mutex> lock(mutex);
+	for(EventType key : {type, EventType::Unknown}){
+		auto byType = routes.find(key);
+		if(byType == routes.end()) continue;
+		for(const std::string& id : {containerId, std::string()}){
+			auto byContainer = byType->second.find(id);
+			if(byContainer != byType->second.end()){
+				matched.insert(matched.end(), byContainer->second.begin(), byContainer->second.end());
+			}
+			if(id.empty()) break;
+		}
+		if(key == EventType::Unknown) break;
+	}
+	// Subscriptions matching both by type and for all types are called in the order they were added.
+	std::sort(matched.begin(), matched.end(), [](const auto& a, const auto& b){ return a->id < b->id; });
+	return matched;
+}
+
+EventDispatcher::EventDispatcher(size_t workerCount) : core(std::make_shared<Core>()){
+	if(dispatching.exchange(true)) throw std::logic_error("Another event dispatcher is already running");
+	try{
+		for(size_t i = 0; i < workerCount; ++i){
+			core->queues.push_back(std::make_unique<BoundedQueue<Delivery>>(EVENT_DISPATCH_QUEUE_DEPTH));
+		}
+		for(size_t i = 0; i < workerCount; ++i){
+			workers.emplace_back(work, core, i);
+		}
+		dispatcher = std::thread(loop, core);
+	}catch(...){
+		for(auto& queue : core->queues) queue->close();
+		for(auto& worker : workers) worker.join();
+		dispatching = false;
+		throw;
+	}
+}
+
+EventDispatcher::~EventDispatcher(){
+	try{
+		stop();
+	}catch(...){}
+}
+
+int64_t EventDispatcher::subscribe(EventType type, const std::string& containerId, EventCallback callback, void* context,
+								   EventContextRelease release){
+	if(!callback) throw std::invalid_argument("The event callback is null");
+	auto subscription = std::make_shared<Subscription>();
+	subscription->callback = callback;
+	subscription->context = context;
+	std::lock_guard<std::mutex> lock(core->mutex);
+	subscription->id = core->nextId++;
+	core->routes[type][containerId].push_back(subscription);
+	core->keys.emplace(subscription->id, std::make_pair(type, containerId));
+	// Set last, so a failed subscription leaves the context to the caller.
+	subscription->release = release;
+	return subscription->id;
+}
+
+void EventDispatcher::unsubscribe(int64_t id){
+	std::shared_ptr<Subscription> removed;
+	{
+		std::lock_guard<std::mutex> lock(core->mutex);
+		auto key = core->keys.find(id);
+		if(key == core->keys.end()) throw std::invalid_argument("Unknown event subscription");
+		auto& byType = core->routes[key->second.first];
+		auto& subscriptions = byType[key->second.second];
+		auto it = std::find_if(subscriptions.begin(), subscriptions.end(), [id](const auto& s){ return s->id == id; });
+		removed = *it;
+		subscriptions.erase(it);
+		if(subscriptions.empty()) byType.erase(key->second.second);
+		if(byType.empty()) core->routes.erase(key->second.first);
+		core->keys.erase(key);
+	}
+	removed->active = false;
+}
+
+void EventDispatcher::stop(){
+	std::lock_guard<std::mutex> lock(stopMutex);
+	if(core->stopping.exchange(true)) return;
+	if(dispatcher.joinable()) core::EventQueue::getInstance().emitBreakEvent();
+	finish(dispatcher);
+	for(auto& queue : core->queues) queue->close();
+	for(auto& worker : workers) finish(worker);
+	std::lock_guard<std::mutex> routesLock(core->mutex);
+	core->routes.clear();
+	core->keys.clear();
+}
+
+void EventDispatcher::loop(std::shared_ptr<Core> core){
+	auto queue = core::EventQueue::getInstance();
+	while(true){
+		std::optional<core::EventHolder> event;
+		try{
+			event = takeEvent(queue, true);
+		}catch(...){
+			if(core->stopping) break;
+			continue;
+		}
+		EventType type = classifyEvent(*event);
+		if(type == EventType::LibBreak && core->stopping) break;
+		std::string containerId = eventContainerId(*event, type);
+		Delivery delivery{.event = std::move(*event), .type = type, .subscriptions = core->match(type, containerId)};
+		if(delivery.subscriptions.empty()) continue;
+		if(core->queues.empty()){
+			deliver(delivery);
+		}else{
+			size_t index = std::hash<std::string>{}(containerId) % core->queues.size();
+			if(!core->queues[index]->push(std::move(delivery))) break;
+		}
+	}
+	dispatching = false;
+}
+
+void EventDispatcher::work(std::shared_ptr<Core> core, size_t index){
+	while(auto delivery = core->queues[index]->pop()){
+		deliver(*delivery);
+	}
+}
+
+void EventDispatcher::deliver(const Delivery& delivery){
+	for(const auto& subscription : delivery.subscriptions){
+		if(!subscription->active) continue;
+		try{
+			subscription->callback(subscription->context, &delivery.event, delivery.type);
+		}catch(...){}
+	}
+}
+
+}
+}
@@ -0,0 +1,104 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef _PRIVMX_ENDPOINT_SWIFT_NATIVE_EventDispatcher_hpp
+#define _PRIVMX_ENDPOINT_SWIFT_NATIVE_EventDispatcher_hpp
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "NativeEventDispatcher.hpp"
+#include "FileTransferUtils.hpp"
+
+namespace privmx {
+namespace transfer {
+
+/// Number of events waiting for a single worker of `EventDispatcher` before the dispatching thread is held back.
+constexpr size_t EVENT_DISPATCH_QUEUE_DEPTH = 1024;
+
+/**
+ * Takes the events from the event queue on its own thread and passes them to the matching subscriptions.
+ *
+ * Every event is classified once. Without workers the callbacks run on the dispatching thread, otherwise on one of the workers,
+ * chosen by the container ID of the event, so the events of a single Thread, Store or Inbox keep their order.
+ * Only one dispatcher can run at a time, as they would compete for the events of the shared queue.
+ */
+class EventDispatcher{
+public:
+	explicit EventDispatcher(size_t workers);
+	~EventDispatcher();
+
+	EventDispatcher(const EventDispatcher&) = delete;
+	EventDispatcher& operator=(const EventDispatcher&) = delete;
+
+	/**
+	 * Adds a subscription, `EventType::Unknown` matches events of every type and an empty `containerId` events of every container.
+	 *
+	 * `release` is called with `context` once the subscription has ended and its callbacks have returned.
+	 */
+	int64_t subscribe(EventType type, const std::string& containerId, EventCallback callback, void* context,
+					  EventContextRelease release);
+
+	/// Ends a subscription. Events already passed to a worker are not delivered any more.
+	void unsubscribe(int64_t id);
+
+	/// Stops taking events and waits for the callbacks running at the moment, unless called from one of them.
+	void stop();
+
+private:
+	struct Subscription{
+		int64_t id;
+		EventCallback callback;
+		void* context;
+		EventContextRelease release;
+		std::atomic<bool> active{true};
+
+		~Subscription();
+	};
+
+	using Subscriptions = std::vector<std::shared_ptr<Subscription>>;
+
+	struct Delivery{
+		endpoint::core::EventHolder event;
+		EventType type;
+		Subscriptions subscriptions;
+	};
+
+	struct Core{
+		std::mutex mutex;
+		std::unordered_map<EventType, std::unordered_map<std::string, Subscriptions>> routes;
+		std::unordered_map<int64_t, std::pair<EventType, std::string>> keys;
+		int64_t nextId = 1;
+		std::atomic<bool> stopping{false};
+		std::vector<std::unique_ptr<BoundedQueue<Delivery>>> queues;
+
+		Subscriptions match(EventType type, const std::string& containerId);
+	};
+
+	static void loop(std::shared_ptr<Core> core);
+	static void work(std::shared_ptr<Core> core, size_t index);
+	static void deliver(const Delivery& delivery);
+
+	std::shared_ptr<Core> core;
+	std::mutex stopMutex;
+	std::thread dispatcher;
+	std::vector<std::thread> workers;
+};
+
+}
+}
+
+#endif /* _PRIVMX_ENDPOINT_SWIFT_NATIVE_EventDispatcher_hpp */
@@ -0,0 +1,111 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "EventFilter.hpp"
+#include "EventClassification.hpp"
+
+#include <algorithm>
+
+namespace privmx {
+namespace transfer {
+
+using namespace endpoint;
+
+namespace {
+
+constexpr size_t EVENT_TYPE_COUNT = static_cast<size_t>(EventType::InboxEntryDeleted) + 1;
+
+std::vector<bool> typeSet(const std::vector<EventType>& types){
+	std::vector<bool> set;
+	for(EventType type : types){
+		size_t index = static_cast<size_t>(type);
+		if(index >= EVENT_TYPE_COUNT) continue;
+		set.resize(EVENT_TYPE_COUNT, false);
+		set[index] = true;
+	}
+	return set;
+}
+
+bool contains(const std::vector<bool>& set, EventType type){
+	size_t index = static_cast<size_t>(type);
+	return index < set.size() && set[index];
+}
+
+}
+
+EventFilter& EventFilter::instance(){
+	static EventFilter filter;
+	return filter;
+}
+
+bool EventFilter::Rules::empty() const{
+	return allowedTypes.empty() && deniedTypes.empty() && !filtersContainers();
+}
+
+bool EventFilter::Rules::filtersContainers() const{
+	return !allowedContainers.empty() || !deniedContainers.empty();
+}
+
+bool EventFilter::Rules::accepts(EventType type, const std::string& containerId) const{
+	if(type == EventType::LibBreak) return true;
+	if(contains(deniedTypes, type)) return false;
+	if(!allowedTypes.empty() && !contains(allowedTypes, type)) return false;
+	if(containerId.empty()) return true;
+	if(deniedContainers.count(containerId)) return false;
+	return allowedContainers.empty() || allowedContainers.count(containerId);
+}
+
+std::shared_ptr<const EventFilter::Rules> EventFilter::current(){
+	std::lock_guard<std::mutex> lock(mutex);
+	return rules;
+}
+
+void EventFilter::update(const std::function<void(Rules&)>& change){
+	std::lock_guard<std::mutex> lock(mutex);
+	auto next = rules ? std::make_shared<Rules>(*rules) : std::make_shared<Rules>();
+	change(*next);
+	if(next->empty()){
+		rules.reset();
+	}else{
+		rules = next;
+	}
+}
+
+void EventFilter::setTypes(const std::vector<EventType>& allowed, const std::vector<EventType>& denied){
+	auto allowedSet = typeSet(allowed);
+	auto deniedSet = typeSet(denied);
+	update([&](Rules& next){
+		next.allowedTypes = std::move(allowedSet);
+		next.deniedTypes = std::move(deniedSet);
+	});
+}
+
+void EventFilter::setContainers(const std::vector<std::string>& allowed, const std::vector<std::string>& denied){
+	update([&](Rules& next){
+		next.allowedContainers = std::unordered_set<std::string>(allowed.begin(), allowed.end());
+		next.deniedContainers = std::unordered_set<std::string>(denied.begin(), denied.end());
+	});
+}
+
+void EventFilter::clear(){
+	std::lock_guard<std::mutex> lock(mutex);
+	rules.reset();
+}
+
+bool EventFilter::accepts(const core::EventHolder& event){
+	auto snapshot = current();
+	if(!snapshot) return true;
+	EventType type = classifyEvent(event);
+	return snapshot->accepts(type, snapshot->filtersContainers() ? eventContainerId(event, type) : std::string());
+}
+
+}
+}
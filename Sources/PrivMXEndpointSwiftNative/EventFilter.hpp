@@ -0,0 +1,67 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef _PRIVMX_ENDPOINT_SWIFT_NATIVE_EventFilter_hpp
+#define _PRIVMX_ENDPOINT_SWIFT_NATIVE_EventFilter_hpp
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "NativeEventClassifier.hpp"
+
+namespace privmx {
+namespace transfer {
+
+/**
+ * Process-wide allow and deny lists of the events handed over from the event queue, shared like the queue itself.
+ *
+ * An event passes when its type and its container ID are each allowed: not denied, and listed when the allow list is not empty.
+ * Events without a container only go through the type lists, break events always pass.
+ */
+class EventFilter{
+public:
+	static EventFilter& instance();
+
+	void setTypes(const std::vector<EventType>& allowed, const std::vector<EventType>& denied);
+	void setContainers(const std::vector<std::string>& allowed, const std::vector<std::string>& denied);
+	void clear();
+
+	/// Returns whether an event passes the filter, without classifying it when there are no lists.
+	bool accepts(const endpoint::core::EventHolder& event);
+
+private:
+	struct Rules{
+		std::vector<bool> allowedTypes;
+		std::vector<bool> deniedTypes;
+		std::unordered_set<std::string> allowedContainers;
+		std::unordered_set<std::string> deniedContainers;
+
+		bool empty() const;
+		bool filtersContainers() const;
+		bool accepts(EventType type, const std::string& containerId) const;
+	};
+
+	EventFilter() = default;
+	std::shared_ptr<const Rules> current();
+	void update(const std::function<void(Rules&)>& change);
+
+	std::mutex mutex;
+	std::shared_ptr<const Rules> rules; ///< Replaced as a whole, `nullptr` when nothing is filtered
+};
+
+}
+}
+
+#endif /* _PRIVMX_ENDPOINT_SWIFT_NATIVE_EventFilter_hpp */
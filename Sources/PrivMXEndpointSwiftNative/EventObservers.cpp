@@ -0,0 +1,47 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "EventObservers.hpp"
+
+#include <algorithm>
+
+namespace privmx {
+namespace transfer {
+
+EventObservers& EventObservers::instance(){
+	static EventObservers observers;
+	return observers;
+}
+
+void EventObservers::add(const std::weak_ptr<void>& owner, const Observer& observer){
+	std::lock_guard<std::mutex> lock(mutex);
+	entries.push_back(Entry{.owner = owner, .observer = observer});
+}
+
+void EventObservers::notify(const endpoint::core::EventHolder& event){
+	std::vector<std::pair<std::shared_ptr<void>, Observer>> live;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		entries.erase(std::remove_if(entries.begin(), entries.end(), [](const Entry& entry){ return entry.owner.expired(); }), entries.end());
+		for(const auto& entry : entries){
+			if(auto owner = entry.owner.lock()) live.emplace_back(owner, entry.observer);
+		}
+	}
+	// Observers run outside of the lock and keep their owners alive until they return.
+	for(const auto& [owner, observer] : live){
+		try{
+			observer(event);
+		}catch(...){}
+	}
+}
+
+}
+}
@@ -0,0 +1,58 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef _PRIVMX_ENDPOINT_SWIFT_NATIVE_EventObservers_hpp
+#define _PRIVMX_ENDPOINT_SWIFT_NATIVE_EventObservers_hpp
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "privmx/endpoint/core/Events.hpp"
+
+namespace privmx {
+namespace transfer {
+
+/**
+ * Process-wide list of native observers of the events taken from the event queue.
+ *
+ * Lets native caches react to changes made by other clients, e.g. drop handles of an updated File,
+ * without the application forwarding the events itself.
+ */
+class EventObservers{
+public:
+	using Observer = std::function<void(const endpoint::core::EventHolder&)>;
+
+	static EventObservers& instance();
+
+	/// Registers an observer for as long as `owner` is alive.
+	void add(const std::weak_ptr<void>& owner, const Observer& observer);
+
+	/// Passes an event to the observers. Called for every event handed over by `NativeEventQueueWrapper`.
+	void notify(const endpoint::core::EventHolder& event);
+
+private:
+	struct Entry{
+		std::weak_ptr<void> owner;
+		Observer observer;
+	};
+
+	EventObservers() = default;
+
+	std::mutex mutex;
+	std::vector<Entry> entries;
+};
+
+}
+}
+
+#endif /* _PRIVMX_ENDPOINT_SWIFT_NATIVE_EventObservers_hpp */
@@ -0,0 +1,56 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "EventPipeline.hpp"
+#include "EventClassification.hpp"
+#include "EventCoalescer.hpp"
+#include "EventFilter.hpp"
+#include "EventObservers.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace privmx {
+namespace transfer {
+
+using namespace endpoint;
+
+std::optional<core::EventHolder> takeEvent(core::EventQueue& queue, bool wait){
+	auto& observers = EventObservers::instance();
+	auto& filter = EventFilter::instance();
+	auto& coalescer = EventCoalescer::instance();
+	std::chrono::milliseconds interval{1};
+	while(true){
+		if(auto ready = coalescer.next()) return ready;
+		std::optional<core::EventHolder> event;
+		auto deadline = coalescer.deadline();
+		if(wait && !deadline){
+			event = queue.waitEvent();
+		}else if(!(event = queue.getEvent())){
+			if(!wait) return std::nullopt;
+			// Held events are due before the queue could wake the caller, so it is polled until then.
+			auto now = std::chrono::steady_clock::now();
+			if(*deadline > now) std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(interval, *deadline - now));
+			interval = std::min(interval * 2, EVENT_POLL_MAX_INTERVAL);
+			continue;
+		}
+		interval = std::chrono::milliseconds(1);
+		observers.notify(*event);
+		if(!filter.accepts(*event)) continue;
+		if(!coalescer.enabled()) return event;
+		EventType type = classifyEvent(*event);
+		std::string containerId = eventContainerId(*event, type);
+		coalescer.add(std::move(*event), type, containerId);
+	}
+}
+
+}
+}
@@ -0,0 +1,37 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef _PRIVMX_ENDPOINT_SWIFT_NATIVE_EventPipeline_hpp
+#define _PRIVMX_ENDPOINT_SWIFT_NATIVE_EventPipeline_hpp
+
+#include <chrono>
+#include <optional>
+
+#include "PrivMXUtils.hpp"
+
+namespace privmx {
+namespace transfer {
+
+/// Longest pause between checks of the queue while events are waited for with a deadline.
+constexpr std::chrono::milliseconds EVENT_POLL_MAX_INTERVAL{16};
+
+/**
+ * Takes the next event to hand over from the queue.
+ *
+ * Passes every event to the native observers, drops the ones rejected by `EventFilter` and holds back the ones
+ * coalesced by `EventCoalescer`. With `wait` blocks until an event is ready, otherwise returns `nullopt` when none is.
+ */
+std::optional<endpoint::core::EventHolder> takeEvent(endpoint::core::EventQueue& queue, bool wait);
+
+}
+}
+
+#endif /* _PRIVMX_ENDPOINT_SWIFT_NATIVE_EventPipeline_hpp */
@@ -0,0 +1,158 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "FileCompression.hpp"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <unistd.h>
+
+#include "Poco/DeflatingStream.h"
+#include "Poco/InflatingStream.h"
+
+namespace privmx {
+namespace transfer {
+
+namespace {
+
+const char COMPRESSED_MAGIC[8] = {'\x89', 'P', 'M', 'X', 'D', 'F', 'L', '\n'};
+/// Frames larger than this are never produced, a header announcing them is not ours.
+constexpr int64_t MAX_FRAME_SIZE = 16 * 1024 * 1024;
+
+uint64_t readLe(const char* data, size_t bytes){
+	uint64_t value = 0;
+	for(size_t i = 0; i < bytes; i++){
+		value |= static_cast<uint64_t>(static_cast<unsigned char>(data[i])) << (8 * i);
+	}
+	return value;
+}
+
+void writeLe(std::string& out, uint64_t value, size_t bytes){
+	for(size_t i = 0; i < bytes; i++){
+		out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+	}
+}
+
+}
+
+int64_t CompressedLayout::dataOffset() const {
+	return COMPRESSED_HEADER_SIZE + 4 * static_cast<int64_t>(frameSizes.size());
+}
+
+int64_t CompressedLayout::storedSize() const {
+	return frameSizes.empty() ? dataOffset() : frameOffsets.back() + frameSizes.back();
+}
+
+int64_t CompressedLayout::frameLength(size_t index) const {
+	return std::min(frameSize, originalSize - static_cast<int64_t>(index) * frameSize);
+}
+
+bool hasCompressedMagic(const char* data, size_t size){
+	return size >= sizeof(COMPRESSED_MAGIC) && std::memcmp(data, COMPRESSED_MAGIC, sizeof(COMPRESSED_MAGIC)) == 0;
+}
+
+int64_t maxCompressedFrameSize(int64_t frameSize){
+	// The conservative bound of zlib's deflateBound(), plus the zlib header and checksum.
+	return frameSize + ((frameSize + 7) >> 3) + ((frameSize + 63) >> 6) + 5 + 6;
+}
+
+std::optional<int64_t> parseCompressedHeader(const char* data, size_t size, int64_t storedSize, int64_t& frameSize, int64_t& originalSize){
+	if(size < COMPRESSED_HEADER_SIZE || !hasCompressedMagic(data, size)) return std::nullopt;
+	frameSize = readLe(data + 8, 4);
+	int64_t frameCount = readLe(data + 12, 4);
+	uint64_t original = readLe(data + 16, 8);
+	if(frameSize <= 0 || frameSize > MAX_FRAME_SIZE || original > static_cast<uint64_t>(INT64_MAX - MAX_FRAME_SIZE)) return std::nullopt;
+	originalSize = static_cast<int64_t>(original);
+	if(frameCount != (originalSize + frameSize - 1) / frameSize) return std::nullopt;
+	// Every frame takes at least one byte, so the table and the frames have to fit in the stored content.
+	if(COMPRESSED_HEADER_SIZE + 5 * frameCount > storedSize) return std::nullopt;
+	return frameCount;
+}
+
+std::optional<CompressedLayout> makeCompressedLayout(int64_t frameSize, int64_t originalSize, const char* table, size_t size,
+													 int64_t storedSize){
+	CompressedLayout layout{.frameSize = frameSize, .originalSize = originalSize};
+	size_t frameCount = size / 4;
+	const int64_t maxFrame = maxCompressedFrameSize(frameSize);
+	layout.frameSizes.reserve(frameCount);
+	layout.frameOffsets.reserve(frameCount);
+	int64_t offset = COMPRESSED_HEADER_SIZE + 4 * static_cast<int64_t>(frameCount);
+	for(size_t i = 0; i < frameCount; i++){
+		int64_t frame = readLe(table + 4 * i, 4);
+		if(frame <= 0 || frame > maxFrame || frame > storedSize - offset) return std::nullopt;
+		layout.frameSizes.push_back(frame);
+		layout.frameOffsets.push_back(offset);
+		offset += frame;
+	}
+	if(offset != storedSize) return std::nullopt;
+	return layout;
+}
+
+std::string encodeCompressedHeader(const CompressedLayout& layout){
+	std::string out(COMPRESSED_MAGIC, sizeof(COMPRESSED_MAGIC));
+	writeLe(out, layout.frameSize, 4);
+	writeLe(out, layout.frameSizes.size(), 4);
+	writeLe(out, layout.originalSize, 8);
+	for(int64_t frame : layout.frameSizes){
+		writeLe(out, frame, 4);
+	}
+	return out;
+}
+
+CompressedLayout compressFile(MappedFile& source, OutputFile& out, int level){
+	CompressedLayout layout{.frameSize = COMPRESSION_FRAME_SIZE, .originalSize = source.size()};
+	int64_t offset = COMPRESSED_HEADER_SIZE + 4 * ((source.size() + COMPRESSION_FRAME_SIZE - 1) / COMPRESSION_FRAME_SIZE);
+	source.forEachChunk(COMPRESSION_FRAME_SIZE, [&](const char* data, size_t size){
+		std::ostringstream frame;
+		Poco::DeflatingOutputStream deflater(frame, Poco::DeflatingStreamBuf::STREAM_ZLIB, level);
+		deflater.write(data, size);
+		deflater.close();
+		const std::string compressed = frame.str();
+		out.write(compressed.data(), compressed.size());
+		layout.frameSizes.push_back(compressed.size());
+		layout.frameOffsets.push_back(offset);
+		offset += compressed.size();
+	});
+	return layout;
+}
+
+void inflateFrame(const char* data, size_t size, char* dst, int64_t length){
+	std::istringstream frame(std::string(data, size));
+	Poco::InflatingInputStream inflater(frame, Poco::InflatingStreamBuf::STREAM_ZLIB);
+	inflater.read(dst, length);
+	if(inflater.gcount() != length || inflater.get() != std::char_traits<char>::eof()){
+		throw std::runtime_error("Corrupted frame of a compressed file");
+	}
+}
+
+TemporaryFile::TemporaryFile(){
+	const char* directory = std::getenv("TMPDIR");
+	std::string pattern = std::string(directory && *directory ? directory : "/tmp") + "/privmx-XXXXXX";
+	std::vector<char> name(pattern.begin(), pattern.end());
+	name.push_back('\0');
+	int fd = ::mkstemp(name.data());
+	if(fd < 0){
+		throw std::system_error(errno, std::generic_category(), "Failed to create a temporary file");
+	}
+	::close(fd);
+	filePath = name.data();
+}
+
+TemporaryFile::~TemporaryFile(){
+	::unlink(filePath.c_str());
+}
+
+}
+}
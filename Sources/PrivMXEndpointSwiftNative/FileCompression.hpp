@@ -0,0 +1,101 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef _PRIVMX_ENDPOINT_SWIFT_NATIVE_FileCompression_hpp
+#define _PRIVMX_ENDPOINT_SWIFT_NATIVE_FileCompression_hpp
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "FileTransferUtils.hpp"
+
+namespace privmx {
+namespace transfer {
+
+/// Amount of content compressed into a single independently inflatable frame.
+constexpr int64_t COMPRESSION_FRAME_SIZE = 256 * 1024;
+/// Size of the fixed part of the header of a compressed File, followed by the frame table.
+constexpr int64_t COMPRESSED_HEADER_SIZE = 24;
+
+/**
+ * Layout of File content stored as a sequence of deflated frames.
+ *
+ * The stored content starts with an 8 byte magic, the frame size, the frame count and the original size,
+ * followed by a table of the compressed frame sizes and the frames themselves. All integers are little-endian.
+ */
+struct CompressedLayout{
+	int64_t frameSize = COMPRESSION_FRAME_SIZE;
+	int64_t originalSize = 0;
+	std::vector<int64_t> frameSizes; ///< Compressed size of each frame
+	std::vector<int64_t> frameOffsets; ///< Position of each frame in the stored content
+
+	/// Position of the first frame, right after the frame table.
+	int64_t dataOffset() const;
+	int64_t storedSize() const;
+	/// Original size of the frame.
+	int64_t frameLength(size_t index) const;
+};
+
+/// Returns whether the content starts with the magic of a compressed File.
+bool hasCompressedMagic(const char* data, size_t size);
+
+/// Largest size a frame of `frameSize` bytes can take once deflated.
+int64_t maxCompressedFrameSize(int64_t frameSize);
+
+/**
+ * Recognises the fixed part of the header of a compressed File of `storedSize` bytes.
+ *
+ * Headers whose frame table and frames cannot fit in the stored content are rejected,
+ * as the content can be written by any member of the Store.
+ *
+ * @return the number of frames, or `std::nullopt` if the content is not compressed
+ */
+std::optional<int64_t> parseCompressedHeader(const char* data, size_t size, int64_t storedSize, int64_t& frameSize, int64_t& originalSize);
+
+/**
+ * Builds the layout from the values of the fixed header and the frame table read after it.
+ *
+ * @return the layout, or `std::nullopt` if a frame exceeds `maxCompressedFrameSize()` or the frames do not end exactly at `storedSize`
+ */
+std::optional<CompressedLayout> makeCompressedLayout(int64_t frameSize, int64_t originalSize, const char* table, size_t size,
+													 int64_t storedSize);
+
+/// Returns the header and the frame table to be stored in front of the frames.
+std::string encodeCompressedHeader(const CompressedLayout& layout);
+
+/// Deflates the source frame by frame into `out` and returns the resulting layout.
+CompressedLayout compressFile(MappedFile& source, OutputFile& out, int level);
+
+/// Inflates a single frame into `dst`, which must hold exactly `length` bytes.
+void inflateFrame(const char* data, size_t size, char* dst, int64_t length);
+
+/**
+ * Uniquely named file in the temporary directory, removed on destruction.
+ */
+class TemporaryFile{
+public:
+	TemporaryFile();
+	~TemporaryFile();
+	TemporaryFile(const TemporaryFile&) = delete;
+	TemporaryFile& operator=(const TemporaryFile&) = delete;
+
+	const std::string& path() const { return filePath; }
+
+private:
+	std::string filePath;
+};
+
+}
+}
+
+#endif /* _PRIVMX_ENDPOINT_SWIFT_NATIVE_FileCompression_hpp */
@@ -0,0 +1,431 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "FileHandleRegistry.hpp"
+#include "TransferMemoryBudget.hpp"
+#include "ChunkBufferPool.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace privmx {
+namespace transfer {
+
+/// Number of files whose layout is remembered, the map is cleared when it grows past it.
+constexpr size_t MAX_KNOWN_LAYOUTS = 1024;
+
+using namespace endpoint;
+
+FileHandleRegistry::FileHandleRegistry(const FileReadOps& ops, const HandleOps& handleOps) : ops(ops), handlePool(handleOps) {}
+
+void FileHandleRegistry::setReadAheadDepth(size_t depth){
+	readAheadDepth = depth;
+}
+
+void FileHandleRegistry::setBlockCacheSize(int64_t bytes){
+	cache.setCapacity(bytes);
+}
+
+void FileHandleRegistry::setHandlePoolLimits(size_t capacity, std::chrono::milliseconds idleTimeout){
+	handlePool.setLimits(capacity, idleTimeout);
+}
+
+void FileHandleRegistry::setDecompression(bool enabled){
+	decompression = enabled;
+}
+
+int64_t FileHandleRegistry::open(const std::string& fileId){
+	PooledHandle lease = handlePool.acquire(fileId);
+	std::shared_ptr<const CompressedLayout> layout;
+	try{
+		if(lease.reused) ops.seek(lease.handle, 0);
+		layout = detectLayout(fileId, lease.handle);
+	}catch(...){
+		handlePool.discard(lease);
+		throw;
+	}
+	auto state = track(lease.handle);
+	std::lock_guard<std::mutex> lock(state->mutex);
+	state->fileId = fileId;
+	state->lease = lease;
+	state->layout = layout;
+	return lease.handle;
+}
+
+void FileHandleRegistry::opened(int64_t handle, const std::string& fileId){
+	auto state = track(handle);
+	std::lock_guard<std::mutex> lock(state->mutex);
+	state->fileId = fileId;
+}
+
+void FileHandleRegistry::updating(int64_t handle, const std::string& fileId){
+	auto state = track(handle);
+	std::lock_guard<std::mutex> lock(state->mutex);
+	state->updatedFileId = fileId;
+	state->writing = true;
+}
+
+void FileHandleRegistry::creating(int64_t handle){
+	auto state = track(handle);
+	std::lock_guard<std::mutex> lock(state->mutex);
+	state->writing = true;
+}
+
+void FileHandleRegistry::label(int64_t handle, const std::string& label){
+	auto state = find(handle);
+	if(!state) throw std::invalid_argument("The file handle is not open");
+	std::lock_guard<std::mutex> lock(state->mutex);
+	state->label = label;
+}
+
+void FileHandleRegistry::enableDigest(int64_t handle){
+	auto state = find(handle);
+	if(!state) throw std::invalid_argument("The file handle is not open");
+	std::lock_guard<std::mutex> lock(state->mutex);
+	if(!state->digest) state->digest = std::make_unique<Sha256Digest>();
+}
+
+void FileHandleRegistry::written(int64_t handle, const char* data, size_t size){
+	auto state = find(handle);
+	if(!state) return;
+	std::lock_guard<std::mutex> lock(state->mutex);
+	if(state->digest && size > 0) state->digest->update(data, size);
+}
+
+std::optional<FileDigest> FileHandleRegistry::digest(int64_t handle){
+	auto state = find(handle);
+	if(!state) return std::nullopt;
+	std::lock_guard<std::mutex> lock(state->mutex);
+	if(!state->digest) return std::nullopt;
+	return FileDigest{
+		.fileId = state->writing ? state->updatedFileId : state->fileId,
+		.size = state->digest->size(),
+		.sha256 = state->digest->hex()
+	};
+}
+
+std::vector<LiveFileHandle> FileHandleRegistry::live(){
+	std::vector<std::pair<int64_t, std::shared_ptr<FileHandleState>>> snapshot;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		snapshot.assign(states.begin(), states.end());
+	}
+	auto now = std::chrono::steady_clock::now();
+	std::vector<LiveFileHandle> result;
+	result.reserve(snapshot.size());
+	for(const auto& [handle, state] : snapshot){
+		// A handle busy with a long read is reported once the read returns.
+		std::lock_guard<std::mutex> lock(state->mutex);
+		result.push_back(LiveFileHandle{
+			.handle = handle,
+			.fileId = state->writing ? state->updatedFileId : state->fileId,
+			.label = state->label,
+			.writing = state->writing,
+			.bufferedBytes = state->readAhead ? state->readAhead->bufferedBytes() : 0,
+			.ageMs = std::chrono::duration_cast<std::chrono::milliseconds>(now - state->openedAt).count()
+		});
+	}
+	std::sort(result.begin(), result.end(), [](const LiveFileHandle& a, const LiveFileHandle& b){ return a.ageMs > b.ageMs; });
+	return result;
+}
+
+void FileHandleRegistry::invalidate(const std::string& fileId){
+	cache.invalidate(fileId);
+	handlePool.invalidate(fileId);
+	std::lock_guard<std::mutex> lock(layoutMutex);
+	layouts.erase(fileId);
+}
+
+std::shared_ptr<const CompressedLayout> FileHandleRegistry::detectLayout(const std::string& fileId, int64_t handle){
+	if(!decompression) return nullptr;
+	{
+		std::lock_guard<std::mutex> lock(layoutMutex);
+		auto it = layouts.find(fileId);
+		if(it != layouts.end()) return it->second;
+	}
+	std::shared_ptr<const CompressedLayout> layout;
+	ops.seek(handle, 0);
+	std::string header = readStored(handle, COMPRESSED_HEADER_SIZE);
+	int64_t frameSize, originalSize;
+	if(ops.size && hasCompressedMagic(header.data(), header.size())){
+		// A header that does not describe the stored content exactly is not ours, such a File is read as it is.
+		int64_t storedSize = ops.size(fileId);
+		if(auto frameCount = parseCompressedHeader(header.data(), header.size(), storedSize, frameSize, originalSize)){
+			std::string table = readStored(handle, 4 * *frameCount);
+			if(static_cast<int64_t>(table.size()) != 4 * *frameCount) throw std::runtime_error("Truncated frame table of a compressed file");
+			if(auto parsed = makeCompressedLayout(frameSize, originalSize, table.data(), table.size(), storedSize)){
+				layout = std::make_shared<const CompressedLayout>(std::move(*parsed));
+			}
+		}
+	}
+	ops.seek(handle, 0);
+	std::lock_guard<std::mutex> lock(layoutMutex);
+	if(layouts.size() >= MAX_KNOWN_LAYOUTS) layouts.clear();
+	layouts[fileId] = layout;
+	return layout;
+}
+
+std::string FileHandleRegistry::readStored(int64_t handle, int64_t length){
+	std::string out;
+	out.reserve(length);
+	while(static_cast<int64_t>(out.size()) < length){
+		core::Buffer chunk = ops.read(handle, length - out.size());
+		if(chunk.size() == 0) break;
+		out.append(chunk.data(), chunk.size());
+	}
+	return out;
+}
+
+void FileHandleRegistry::readFrame(const CompressedLayout& layout, int64_t handle, size_t index, char* dst, bool reserved){
+	MemoryReservation reservation;
+	if(!reserved) reservation = TransferMemoryBudget::instance().reserve(layout.frameSizes[index]);
+	ops.seek(handle, layout.frameOffsets[index]);
+	std::string stored = readStored(handle, layout.frameSizes[index]);
+	if(static_cast<int64_t>(stored.size()) != layout.frameSizes[index]) throw std::runtime_error("Truncated frame of a compressed file");
+	inflateFrame(stored.data(), stored.size(), dst, layout.frameLength(index));
+}
+
+int64_t FileHandleRegistry::readCompressed(const CompressedLayout& layout, int64_t handle, int64_t& position, char* dst, int64_t capacity,
+										   std::vector<char>& frame, int64_t& frameIndex){
+	int64_t copied = 0;
+	while(copied < capacity && position < layout.originalSize){
+		int64_t index = position / layout.frameSize;
+		if(index != frameIndex){
+			// Keeps the frame, so the next small read or a seek within it does not inflate it again.
+			frameIndex = -1;
+			frame.resize(layout.frameLength(index));
+			readFrame(layout, handle, index, frame.data());
+			frameIndex = index;
+		}
+		int64_t offset = position - index * layout.frameSize;
+		int64_t take = std::min<int64_t>(frame.size() - offset, capacity - copied);
+		std::memcpy(dst + copied, frame.data() + offset, take);
+		copied += take;
+		position += take;
+	}
+	return copied;
+}
+
+std::shared_ptr<FileHandleState> FileHandleRegistry::track(int64_t handle){
+	std::lock_guard<std::mutex> lock(mutex);
+	auto& state = states[handle];
+	if(!state) state = std::make_shared<FileHandleState>();
+	return state;
+}
+
+std::shared_ptr<FileHandleState> FileHandleRegistry::find(int64_t handle){
+	std::lock_guard<std::mutex> lock(mutex);
+	auto it = states.find(handle);
+	return it == states.end() ? nullptr : it->second;
+}
+
+core::Buffer FileHandleRegistry::read(int64_t handle, int64_t length){
+	auto state = find(handle);
+	// Unknown or closed handles are not tracked, otherwise every such read would leave a handle reported as live.
+	if(!state) return ops.read(handle, length);
+	std::lock_guard<std::mutex> lock(state->mutex);
+	core::Buffer chunk;
+	if(state->layout){
+		int64_t available = std::max<int64_t>(0, std::min(length, state->layout->originalSize - state->position));
+		auto reservation = TransferMemoryBudget::instance().reserve(available);
+		PooledBuffer out = ChunkBufferPool::instance().acquire(available);
+		out.resize(readCompressed(*state->layout, handle, state->position, out.data(), out.size(), state->frame, state->frameIndex));
+		chunk = ChunkBufferPool::instance().copyToBuffer(out.data(), out.size());
+	}else if(state->readAhead){
+		chunk = state->readAhead->read(length);
+		state->position += chunk.size();
+	}else if(!state->fileId.empty() && cache.enabled()){
+		int64_t available = cachedReadLength(state->fileId, state->position, length);
+		// One reservation covers the output and a block being fetched, a second one could wait for the first forever.
+		auto reservation = TransferMemoryBudget::instance().reserve(available + CACHE_BLOCK_SIZE);
+		PooledBuffer out = ChunkBufferPool::instance().acquire(available);
+		out.resize(readCached(*state, handle, out.data(), available, true));
+		chunk = ChunkBufferPool::instance().copyToBuffer(out.data(), out.size());
+	}else{
+		chunk = readDirect(*state, handle, length);
+	}
+	digestRead(*state, chunk.data(), chunk.size());
+	return chunk;
+}
+
+int64_t FileHandleRegistry::readInto(int64_t handle, char* dst, int64_t capacity){
+	auto state = find(handle);
+	if(!state){
+		core::Buffer chunk = ops.read(handle, capacity);
+		std::memcpy(dst, chunk.data(), chunk.size());
+		return chunk.size();
+	}
+	std::lock_guard<std::mutex> lock(state->mutex);
+	int64_t read;
+	if(state->layout){
+		read = readCompressed(*state->layout, handle, state->position, dst, capacity, state->frame, state->frameIndex);
+	}else if(state->readAhead){
+		read = state->readAhead->readInto(dst, capacity);
+		state->position += read;
+	}else if(!state->fileId.empty() && cache.enabled()){
+		read = readCached(*state, handle, dst, capacity);
+	}else{
+		core::Buffer chunk = readDirect(*state, handle, capacity);
+		std::memcpy(dst, chunk.data(), chunk.size());
+		read = chunk.size();
+	}
+	digestRead(*state, dst, read);
+	return read;
+}
+
+void FileHandleRegistry::digestRead(FileHandleState& state, const char* data, int64_t size){
+	if(state.digest && size > 0) state.digest->update(data, size);
+}
+
+core::Buffer FileHandleRegistry::readDirect(FileHandleState& state, int64_t handle, int64_t length){
+	core::Buffer chunk;
+	{
+		auto reservation = TransferMemoryBudget::instance().reserve(length);
+		chunk = ops.read(handle, length);
+	}
+	state.position += chunk.size();
+	trackSequential(state, handle, length, chunk.size());
+	return chunk;
+}
+
+int64_t FileHandleRegistry::readCached(FileHandleState& state, int64_t handle, char* dst, int64_t capacity, bool reserved){
+	int64_t copied = copyBlocks(state.fileId, state.position, handle, dst, capacity, reserved);
+	trackSequential(state, handle, capacity, copied);
+	return copied;
+}
+
+int64_t FileHandleRegistry::copyBlocks(const std::string& fileId, int64_t& position, int64_t handle, char* dst, int64_t capacity,
+									   bool reserved){
+	int64_t copied = 0;
+	while(copied < capacity){
+		int64_t blockIndex = position / CACHE_BLOCK_SIZE;
+		int64_t offset = position % CACHE_BLOCK_SIZE;
+		BlockCache::Block block = cache.get(fileId, blockIndex);
+		if(!block){
+			MemoryReservation reservation;
+			if(!reserved) reservation = TransferMemoryBudget::instance().reserve(CACHE_BLOCK_SIZE);
+			uint64_t generation = cache.generation();
+			// The cursor of the handle is moved freely here, `position` stays the source of truth.
+			ops.seek(handle, blockIndex * CACHE_BLOCK_SIZE);
+			block = std::make_shared<const core::Buffer>(ops.read(handle, CACHE_BLOCK_SIZE));
+			cache.put(fileId, blockIndex, block, generation);
+		}
+		if(offset >= static_cast<int64_t>(block->size())) break; // end of the file
+		int64_t take = std::min<int64_t>(block->size() - offset, capacity - copied);
+		std::memcpy(dst + copied, block->data() + offset, take);
+		copied += take;
+		position += take;
+		if(static_cast<int64_t>(block->size()) < CACHE_BLOCK_SIZE && offset + take == static_cast<int64_t>(block->size())) break;
+	}
+	return copied;
+}
+
+int64_t FileHandleRegistry::cachedReadLength(const std::string& fileId, int64_t offset, int64_t length){
+	// A read within a block needs no more than the block, longer ones are clamped to the File before allocating.
+	if(!ops.size || length <= CACHE_BLOCK_SIZE) return length;
+	return std::max<int64_t>(0, std::min(length, ops.size(fileId) - offset));
+}
+
+core::Buffer FileHandleRegistry::readRange(const std::string& fileId, int64_t offset, int64_t length){
+	if(length <= 0) return core::Buffer();
+	PooledHandle lease = handlePool.acquire(fileId);
+	core::Buffer chunk;
+	try{
+		if(auto layout = detectLayout(fileId, lease.handle)){
+			int64_t position = offset;
+			std::vector<char> frame;
+			int64_t frameIndex = -1;
+			int64_t available = std::max<int64_t>(0, std::min(length, layout->originalSize - offset));
+			auto reservation = TransferMemoryBudget::instance().reserve(available);
+			PooledBuffer out = ChunkBufferPool::instance().acquire(available);
+			out.resize(readCompressed(*layout, lease.handle, position, out.data(), available, frame, frameIndex));
+			chunk = ChunkBufferPool::instance().copyToBuffer(out.data(), out.size());
+		}else if(cache.enabled()){
+			int64_t position = offset;
+			int64_t available = cachedReadLength(fileId, offset, length);
+			// One reservation covers the output and a block being fetched, a second one could wait for the first forever.
+			auto reservation = TransferMemoryBudget::instance().reserve(available + CACHE_BLOCK_SIZE);
+			PooledBuffer out = ChunkBufferPool::instance().acquire(available);
+			out.resize(copyBlocks(fileId, position, lease.handle, out.data(), available, true));
+			chunk = ChunkBufferPool::instance().copyToBuffer(out.data(), out.size());
+		}else{
+			auto reservation = TransferMemoryBudget::instance().reserve(length);
+			ops.seek(lease.handle, offset);
+			chunk = ops.read(lease.handle, length);
+		}
+	}catch(...){
+		// The handle may be left in an unknown state, do not hand it to the next read.
+		handlePool.discard(lease);
+		throw;
+	}
+	handlePool.giveBack(lease);
+	return chunk;
+}
+
+void FileHandleRegistry::trackSequential(FileHandleState& state, int64_t handle, int64_t length, int64_t read){
+	size_t depth = readAheadDepth;
+	if(depth == 0 || length <= 0 || read != length){
+		state.sequentialReads = 0;
+		return;
+	}
+	if(++state.sequentialReads >= SEQUENTIAL_READS_THRESHOLD){
+		// Cached reads may have left the cursor of the handle elsewhere.
+		ops.seek(handle, state.position);
+		state.readAhead = std::make_unique<ReadAheadReader>(ops, handle, state.position, length, depth);
+	}
+}
+
+void FileHandleRegistry::seek(int64_t handle, int64_t position){
+	auto state = find(handle);
+	if(!state){
+		ops.seek(handle, position);
+		return;
+	}
+	std::lock_guard<std::mutex> lock(state->mutex);
+	// The prefetched data belongs to the old position and the worker has moved the cursor past it.
+	state->readAhead.reset();
+	state->sequentialReads = 0;
+	// Positions of compressed files are those of the original content, frames are located on the next read.
+	if(!state->layout) ops.seek(handle, position);
+	state->position = position;
+}
+
+std::string FileHandleRegistry::release(int64_t handle){
+	std::shared_ptr<FileHandleState> state;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto it = states.find(handle);
+		if(it == states.end()) return std::string();
+		state = it->second;
+		states.erase(it);
+	}
+	std::lock_guard<std::mutex> lock(state->mutex);
+	state->readAhead.reset();
+	return state->updatedFileId;
+}
+
+std::optional<std::string> FileHandleRegistry::recycle(int64_t handle){
+	auto state = find(handle);
+	if(!state) return std::nullopt;
+	std::lock_guard<std::mutex> lock(state->mutex);
+	if(!state->lease) return std::nullopt;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		states.erase(handle);
+	}
+	state->readAhead.reset();
+	handlePool.giveBack(*state->lease);
+	return state->fileId;
+}
+
+}
+}
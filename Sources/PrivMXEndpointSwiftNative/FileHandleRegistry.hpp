@@ -0,0 +1,199 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef _PRIVMX_ENDPOINT_SWIFT_NATIVE_FileHandleRegistry_hpp
+#define _PRIVMX_ENDPOINT_SWIFT_NATIVE_FileHandleRegistry_hpp
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "PrivMXUtils.hpp"
+#include "BlockCache.hpp"
+#include "FileCompression.hpp"
+#include "FileReadAhead.hpp"
+#include "OpenHandlePool.hpp"
+#include "Sha256Digest.hpp"
+
+namespace privmx {
+namespace transfer {
+
+/// Number of consecutive full-length reads after which a handle is treated as sequentially read.
+constexpr int SEQUENTIAL_READS_THRESHOLD = 2;
+
+/**
+ * Native bookkeeping of a single open file handle.
+ */
+struct FileHandleState{
+	std::mutex mutex;
+	std::string fileId; ///< File read through the handle, empty if unknown
+	std::string updatedFileId; ///< File whose content the handle replaces, empty for read handles
+	int64_t position = 0; ///< Read cursor as seen by the caller
+	bool writing = false; ///< Whether the handle writes the content of a new or existing file
+	std::string label; ///< Set by the owner of the handle to find the ones never closed
+	std::chrono::steady_clock::time_point openedAt = std::chrono::steady_clock::now();
+	int sequentialReads = 0;
+	std::unique_ptr<ReadAheadReader> readAhead;
+	std::unique_ptr<Sha256Digest> digest; ///< Running digest of the data read or written, if requested
+	std::optional<PooledHandle> lease; ///< Set for handles taken from the handle pool by `open()`
+	std::shared_ptr<const CompressedLayout> layout; ///< Set for compressed files read with transparent decompression
+	std::vector<char> frame; ///< Last inflated frame of a compressed file
+	int64_t frameIndex = -1;
+};
+
+/**
+ * Tracks the file handles of a single Api instance and routes their reads.
+ *
+ * Shared by all copies of a wrapper, so its state outlives the value semantics of the Swift bridge.
+ */
+class FileHandleRegistry{
+public:
+	FileHandleRegistry(const FileReadOps& ops, const HandleOps& handleOps);
+
+	/**
+	 * Sets how many chunks are prefetched for sequentially read handles.
+	 *
+	 * `0` disables read-ahead. Handles that are already prefetching keep their current engine.
+	 */
+	void setReadAheadDepth(size_t depth);
+
+	/**
+	 * Sets the amount of memory used to cache decrypted blocks of read files, `0` disables the cache.
+	 *
+	 * Reads of handles opened with a known file ID are served from cached blocks until the handle is read sequentially.
+	 */
+	void setBlockCacheSize(int64_t bytes);
+
+	/**
+	 * Sets how many idle read handles are kept open and for how long, see `OpenHandlePool::setLimits()`. Disabled by default.
+	 *
+	 * Idle handles only learn about changes made by other clients through `invalidate()`, called by the owner on file events.
+	 */
+	void setHandlePoolLimits(size_t capacity, std::chrono::milliseconds idleTimeout);
+
+	/**
+	 * Enables transparent decompression of files uploaded compressed.
+	 *
+	 * Handles opened by `open()` and `readRange()` then see the original content, and positions are those of the original content.
+	 * Compressed files are read frame by frame and bypass read-ahead and the block cache.
+	 */
+	void setDecompression(bool enabled);
+
+	/// Opens a file to read, reusing an idle handle of the file when there is one. The handle is returned to the pool by `recycle()`.
+	int64_t open(const std::string& fileId);
+
+	/// Records the file read through a freshly opened handle.
+	void opened(int64_t handle, const std::string& fileId);
+
+	/// Records a handle that replaces the content of an existing file.
+	void updating(int64_t handle, const std::string& fileId);
+
+	/// Records a handle that writes the content of a new file.
+	void creating(int64_t handle);
+
+	/// Labels a handle, so a handle that is never closed can be traced back to its owner. Throws for a handle that is not open.
+	void label(int64_t handle, const std::string& label);
+
+	/// Returns the handles not released yet. Idle handles of the handle pool are not included.
+	std::vector<LiveFileHandle> live();
+
+	/// Starts a running SHA-256 of the data read through or written to the handle, from the next read or write on.
+	/// Throws for a handle that is not open.
+	void enableDigest(int64_t handle);
+
+	/// Passes data successfully written to the handle to its digest. Unknown handles are ignored.
+	void written(int64_t handle, const char* data, size_t size);
+
+	/// Returns the digest of the handle, `nullopt` if it was not enabled.
+	std::optional<FileDigest> digest(int64_t handle);
+
+	/// Drops the cached blocks and idle handles of a file whose content has changed.
+	void invalidate(const std::string& fileId);
+
+	/**
+	 * Reads up to `length` bytes of a file starting at `offset`, without a handle of the caller.
+	 *
+	 * Uses an idle handle of the file from the handle pool when there is one, and is served from the block cache when it is enabled.
+	 */
+	endpoint::core::Buffer readRange(const std::string& fileId, int64_t offset, int64_t length);
+
+	/// Reads through the handle. Handles that are not open are passed to the Api as they are, so it reports the error.
+	endpoint::core::Buffer read(int64_t handle, int64_t length);
+
+	/**
+	 * Returns the layout of a compressed file, `nullptr` if the file is not compressed or decompression is disabled.
+	 *
+	 * Reads the header through `handle` on the first call for the file and leaves its cursor at the start of the file.
+	 */
+	std::shared_ptr<const CompressedLayout> detectLayout(const std::string& fileId, int64_t handle);
+
+	/**
+	 * Reads and inflates a single frame of a compressed file into `dst`, which must hold `layout.frameLength(index)` bytes.
+	 *
+	 * `reserved` tells that the caller already holds a reservation of the transfer memory budget for the frame,
+	 * the stored frame is then not reserved again, so a chunk never waits for the budget twice.
+	 */
+	void readFrame(const CompressedLayout& layout, int64_t handle, size_t index, char* dst, bool reserved = false);
+
+	/// Reads up to `capacity` bytes straight into `dst`, returns the number of bytes read.
+	int64_t readInto(int64_t handle, char* dst, int64_t capacity);
+
+	void seek(int64_t handle, int64_t position);
+
+	/**
+	 * Stops any background work of the handle and forgets it. Must be called before the handle is closed.
+	 *
+	 * @return ID of the file whose content the handle replaces, to be invalidated once the handle is closed, empty for read handles
+	 */
+	std::string release(int64_t handle);
+
+	/**
+	 * Parks a handle obtained from `open()` for reuse instead of closing it.
+	 *
+	 * @return ID of the file read through the handle, empty if the handle was not opened by `open()` and has to be closed as usual
+	 */
+	std::optional<std::string> recycle(int64_t handle);
+
+private:
+	/// Returns the state of the handle, starting to track it if it is not tracked yet. Only called when a handle is opened.
+	std::shared_ptr<FileHandleState> track(int64_t handle);
+	/// Returns the state of the handle, `nullptr` if it is not open.
+	std::shared_ptr<FileHandleState> find(int64_t handle);
+	endpoint::core::Buffer readDirect(FileHandleState& state, int64_t handle, int64_t length);
+	int64_t readCached(FileHandleState& state, int64_t handle, char* dst, int64_t capacity, bool reserved = false);
+	/// Returns how much of `length` bytes at `offset` a cached read has to allocate.
+	int64_t cachedReadLength(const std::string& fileId, int64_t offset, int64_t length);
+	int64_t copyBlocks(const std::string& fileId, int64_t& position, int64_t handle, char* dst, int64_t capacity, bool reserved = false);
+	void trackSequential(FileHandleState& state, int64_t handle, int64_t length, int64_t read);
+	void digestRead(FileHandleState& state, const char* data, int64_t size);
+	int64_t readCompressed(const CompressedLayout& layout, int64_t handle, int64_t& position, char* dst, int64_t capacity,
+						   std::vector<char>& frame, int64_t& frameIndex);
+	std::string readStored(int64_t handle, int64_t length);
+
+	FileReadOps ops;
+	BlockCache cache;
+	OpenHandlePool handlePool;
+	std::atomic<size_t> readAheadDepth{0};
+	std::atomic<bool> decompression{false};
+	std::mutex mutex;
+	std::unordered_map<int64_t, std::shared_ptr<FileHandleState>> states;
+	std::mutex layoutMutex;
+	std::unordered_map<std::string, std::shared_ptr<const CompressedLayout>> layouts; ///< `nullptr` for files known not to be compressed
+};
+
+}
+}
+
+#endif /* _PRIVMX_ENDPOINT_SWIFT_NATIVE_FileHandleRegistry_hpp */
@@ -0,0 +1,177 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "FileReadAhead.hpp"
+#include "ChunkBufferPool.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace privmx {
+namespace transfer {
+
+using namespace endpoint;
+
+ReadAheadReader::ReadAheadReader(const FileReadOps& ops, int64_t handle, int64_t position, int64_t chunkSize, size_t depth) :
+	ops(ops),
+	handle(handle),
+	chunkSize(chunkSize),
+	depth(depth == 0 ? 1 : depth),
+	position(position)
+{
+	worker = std::thread(&ReadAheadReader::run, this);
+}
+
+ReadAheadReader::~ReadAheadReader(){
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	changed.notify_all();
+	worker.join();
+}
+
+void ReadAheadReader::run(){
+	std::unique_lock<std::mutex> lock(mutex);
+	auto canFetch = [this]{ return stopping || (!parked && !finished && chunks.size() < depth); };
+	while(true){
+		if(chunks.empty()){
+			changed.wait(lock, canFetch);
+		}else if(!changed.wait_until(lock, lastUse + READ_AHEAD_IDLE_TIMEOUT, canFetch)){
+			// Buffered chunks of an abandoned handle would hold their part of the budget for good.
+			if(readers == 0 && std::chrono::steady_clock::now() >= lastUse + READ_AHEAD_IDLE_TIMEOUT) park(lock);
+			continue;
+		}
+		if(stopping) return;
+		lock.unlock();
+		// Waits for memory in slices, so a stop request is never blocked by an exhausted budget.
+		std::optional<MemoryReservation> reservation;
+		while(!reservation){
+			reservation = TransferMemoryBudget::instance().tryReserve(chunkSize, std::chrono::milliseconds(100));
+			std::lock_guard<std::mutex> stopLock(mutex);
+			if(stopping) return;
+		}
+		core::Buffer chunk;
+		std::exception_ptr readError;
+		try{
+			chunk = ops.read(handle, chunkSize);
+		}catch(...){
+			readError = std::current_exception();
+		}
+		lock.lock();
+		if(readError){
+			error = readError;
+			finished = true;
+		}else{
+			int64_t size = chunk.size();
+			if(size > 0){
+				buffered += size;
+				chunks.push_back(PrefetchedChunk{.data = std::move(chunk), .reservation = std::move(*reservation)});
+			}
+			finished = size < chunkSize;
+		}
+		changed.notify_all();
+	}
+}
+
+void ReadAheadReader::park(std::unique_lock<std::mutex>& lock){
+	chunks.clear();
+	buffered = 0;
+	frontOffset = 0;
+	// A read error is retried from the first byte not consumed once reading resumes.
+	error = nullptr;
+	finished = false;
+	parked = true;
+	int64_t resumeAt = position;
+	lock.unlock();
+	std::exception_ptr seekError;
+	try{
+		ops.seek(handle, resumeAt);
+	}catch(...){
+		seekError = std::current_exception();
+	}
+	lock.lock();
+	if(seekError){
+		error = seekError;
+		finished = true;
+		changed.notify_all();
+	}
+}
+
+ReadAheadReader::Reading::Reading(ReadAheadReader& reader) : reader(reader) {
+	reader.readers++;
+	reader.lastUse = std::chrono::steady_clock::now();
+	if(reader.parked){
+		reader.parked = false;
+		reader.changed.notify_all();
+	}
+}
+
+ReadAheadReader::Reading::~Reading(){
+	reader.readers--;
+	reader.lastUse = std::chrono::steady_clock::now();
+}
+
+core::Buffer ReadAheadReader::read(int64_t length){
+	std::unique_lock<std::mutex> lock(mutex);
+	Reading reading(*this);
+	changed.wait(lock, [this]{ return !chunks.empty() || finished; });
+	// The caller reads with the chunk size used for prefetching, so whole chunks are handed over without copying.
+	if(!chunks.empty() && frontOffset == 0 && static_cast<int64_t>(chunks.front().data.size()) == length){
+		core::Buffer chunk = std::move(chunks.front().data);
+		chunks.pop_front();
+		buffered -= chunk.size();
+		position += chunk.size();
+		changed.notify_all();
+		return chunk;
+	}
+	PooledBuffer out = ChunkBufferPool::instance().acquire(length);
+	out.resize(copyOut(lock, out.data(), length));
+	return ChunkBufferPool::instance().copyToBuffer(out.data(), out.size());
+}
+
+int64_t ReadAheadReader::readInto(char* dst, int64_t capacity){
+	std::unique_lock<std::mutex> lock(mutex);
+	Reading reading(*this);
+	return copyOut(lock, dst, capacity);
+}
+
+int64_t ReadAheadReader::copyOut(std::unique_lock<std::mutex>& lock, char* dst, int64_t capacity){
+	int64_t copied = 0;
+	while(copied < capacity){
+		changed.wait(lock, [this]{ return !chunks.empty() || finished; });
+		if(chunks.empty()){
+			if(error && copied == 0) std::rethrow_exception(error);
+			break;
+		}
+		const core::Buffer& front = chunks.front().data;
+		size_t take = std::min<size_t>(front.size() - frontOffset, capacity - copied);
+		std::memcpy(dst + copied, front.data() + frontOffset, take);
+		copied += take;
+		frontOffset += take;
+		position += take;
+		if(frontOffset == front.size()){
+			buffered -= front.size();
+			chunks.pop_front();
+			frontOffset = 0;
+			changed.notify_all();
+		}
+	}
+	return copied;
+}
+
+int64_t ReadAheadReader::bufferedBytes(){
+	std::lock_guard<std::mutex> lock(mutex);
+	return buffered - frontOffset;
+}
+
+}
+}
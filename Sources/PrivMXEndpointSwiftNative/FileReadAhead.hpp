@@ -0,0 +1,113 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef _PRIVMX_ENDPOINT_SWIFT_NATIVE_FileReadAhead_hpp
+#define _PRIVMX_ENDPOINT_SWIFT_NATIVE_FileReadAhead_hpp
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "privmx/endpoint/core/Types.hpp"
+#include "TransferMemoryBudget.hpp"
+
+namespace privmx {
+namespace transfer {
+
+/// Time without reads after which the prefetched chunks of a handle are dropped and their memory returned to the budget.
+constexpr std::chrono::milliseconds READ_AHEAD_IDLE_TIMEOUT{5000};
+
+/**
+ * Reading primitives of an open file handle, shared by the Store and Inbox wrappers.
+ */
+struct FileReadOps{
+	std::function<endpoint::core::Buffer(int64_t handle, int64_t length)> read;
+	std::function<void(int64_t handle, int64_t position)> seek;
+	std::function<int64_t(const std::string& fileId)> size; ///< Stored size of a file, only needed to read compressed files
+};
+
+/**
+ * Chunk waiting in the read-ahead buffer, together with the memory it holds.
+ */
+struct PrefetchedChunk{
+	endpoint::core::Buffer data;
+	MemoryReservation reservation;
+};
+
+/**
+ * Prefetches consecutive chunks of an open file on a background thread.
+ *
+ * Starts reading at `position`, which must be the current cursor of the handle, and keeps at most `depth` chunks buffered,
+ * each reserved against the transfer memory budget. When the handle is not read for `READ_AHEAD_IDLE_TIMEOUT`, the buffered
+ * chunks are dropped and the cursor is moved back to the first byte not consumed, prefetching resumes with the next read.
+ * While it is alive, the handle must not be used directly — it is only read and moved from the worker thread.
+ */
+class ReadAheadReader{
+public:
+	ReadAheadReader(const FileReadOps& ops, int64_t handle, int64_t position, int64_t chunkSize, size_t depth);
+	~ReadAheadReader();
+	ReadAheadReader(const ReadAheadReader&) = delete;
+	ReadAheadReader& operator=(const ReadAheadReader&) = delete;
+
+	/**
+	 * Returns the next `length` bytes of the file, waiting for the worker if needed.
+	 *
+	 * Returns fewer bytes at the end of the file. A read error of the worker is rethrown once the data read before it has been consumed.
+	 */
+	endpoint::core::Buffer read(int64_t length);
+
+	/// Copies up to `capacity` bytes of the file into `dst` and returns how many were copied, following the rules of `read()`.
+	int64_t readInto(char* dst, int64_t capacity);
+
+	/// Amount of bytes fetched from the Platform but not consumed yet.
+	int64_t bufferedBytes();
+
+private:
+	void run();
+	void park(std::unique_lock<std::mutex>& lock);
+	/// Counts a caller inside `read()` or `readInto()`, constructed and destroyed with the lock held.
+	struct Reading{
+		explicit Reading(ReadAheadReader& reader);
+		~Reading();
+		ReadAheadReader& reader;
+	};
+
+	int64_t copyOut(std::unique_lock<std::mutex>& lock, char* dst, int64_t capacity);
+
+	FileReadOps ops;
+	const int64_t handle;
+	const int64_t chunkSize;
+	const size_t depth;
+
+	std::mutex mutex;
+	std::condition_variable changed;
+	std::deque<PrefetchedChunk> chunks;
+	size_t frontOffset = 0;
+	int64_t buffered = 0;
+	int64_t position; ///< Offset of the first byte not consumed by the caller
+	std::chrono::steady_clock::time_point lastUse = std::chrono::steady_clock::now();
+	int readers = 0; ///< Callers inside `read()` or `readInto()`, whose chunks are never dropped
+	bool parked = false; ///< Set while idle, until the next read
+	bool finished = false;
+	bool stopping = false;
+	std::exception_ptr error;
+	std::thread worker;
+};
+
+}
+}
+
+#endif /* _PRIVMX_ENDPOINT_SWIFT_NATIVE_FileReadAhead_hpp */
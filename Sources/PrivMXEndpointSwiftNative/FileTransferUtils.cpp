@@ -0,0 +1,163 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "FileTransferUtils.hpp"
+#include "TransferMemoryBudget.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+
+namespace privmx {
+namespace transfer {
+
+MappedFile::MappedFile(const std::string& path){
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if(fd < 0){
+		throw std::system_error(errno, std::generic_category(), "Failed to open " + path);
+	}
+	struct stat info;
+	if(::fstat(fd, &info) != 0){
+		int err = errno;
+		::close(fd);
+		throw std::system_error(err, std::generic_category(), "Failed to stat " + path);
+	}
+	fileSize = info.st_size;
+	// An empty file cannot be mapped and has nothing to feed anyway.
+	if(fileSize > 0){
+		mapping = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+		if(mapping == MAP_FAILED){
+			int err = errno;
+			mapping = nullptr;
+			::close(fd);
+			throw std::system_error(err, std::generic_category(), "Failed to map " + path);
+		}
+		::madvise(mapping, fileSize, MADV_SEQUENTIAL);
+	}
+	// The mapping keeps its own reference to the file.
+	::close(fd);
+}
+
+MappedFile::~MappedFile(){
+	if(mapping) ::munmap(mapping, fileSize);
+}
+
+void MappedFile::advise(int64_t offset, int64_t length, int advice){
+	static const int64_t pageSize = ::sysconf(_SC_PAGESIZE);
+	int64_t begin = offset - offset % pageSize;
+	int64_t end = std::min(offset + length, fileSize);
+	if(end <= begin) return;
+	// Advice errors only cost performance, the mapping stays valid.
+	::madvise(static_cast<char*>(mapping) + begin, end - begin, advice);
+}
+
+void MappedFile::forEachChunk(int64_t chunkSize, const std::function<void(const char* data, size_t size)>& consume){
+	forEachChunk([chunkSize]{ return chunkSize; }, consume);
+}
+
+void MappedFile::forEachChunk(const std::function<int64_t()>& chunkSize, const std::function<void(const char* data, size_t size)>& consume){
+	const char* data = static_cast<const char*>(mapping);
+	for(int64_t offset = 0; offset < fileSize;){
+		int64_t size = chunkSize();
+		if(size <= 0) throw std::invalid_argument("The chunk size must be positive");
+		int64_t length = std::min(size, fileSize - offset);
+		advise(offset + length, size, MADV_WILLNEED);
+		consume(data + offset, length);
+		// Dropping a page shared with the next part only costs a refault from the page cache.
+		advise(offset, length, MADV_DONTNEED);
+		offset += length;
+	}
+}
+
+OutputFile::OutputFile(const std::string& path){
+	fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if(fd < 0){
+		throw std::system_error(errno, std::generic_category(), "Failed to open " + path);
+	}
+}
+
+OutputFile::~OutputFile(){
+	if(fd >= 0) ::close(fd);
+}
+
+void OutputFile::write(const char* data, size_t size){
+	size_t total = 0;
+	while(total < size){
+		ssize_t n = ::write(fd, data + total, size - total);
+		if(n < 0){
+			if(errno == EINTR) continue;
+			throw std::system_error(errno, std::generic_category(), "Failed to write target file");
+		}
+		total += n;
+	}
+}
+
+void OutputFile::sync(){
+	if(::fsync(fd) != 0){
+		throw std::system_error(errno, std::generic_category(), "Failed to sync target file");
+	}
+}
+
+namespace {
+
+struct ReservedBuffer{
+	endpoint::core::Buffer data;
+	MemoryReservation reservation;
+};
+
+}
+
+int64_t downloadToPath(const std::string& path,
+					   const std::function<int64_t()>& chunkSize,
+					   int64_t syncInterval,
+					   const std::function<endpoint::core::Buffer(int64_t length)>& readChunk){
+	const std::string partPath = path + ".part";
+	int64_t written = 0;
+	try{
+		OutputFile target(partPath);
+		int64_t unsynced = 0;
+		runPipeline<ReservedBuffer>(
+			[&](ReservedBuffer& chunk){
+				int64_t length = chunkSize();
+				chunk.reservation = TransferMemoryBudget::instance().reserve(length);
+				chunk.data = readChunk(length);
+				return chunk.data.size() > 0;
+			},
+			[&](ReservedBuffer& chunk){
+				target.write(chunk.data.data(), chunk.data.size());
+				written += chunk.data.size();
+				unsynced += chunk.data.size();
+				if(syncInterval > 0 && unsynced >= syncInterval){
+					target.sync();
+					unsynced = 0;
+				}
+			});
+		if(syncInterval > 0 && unsynced > 0) target.sync();
+	}catch(...){
+		::unlink(partPath.c_str());
+		throw;
+	}
+	if(::rename(partPath.c_str(), path.c_str()) != 0){
+		int err = errno;
+		::unlink(partPath.c_str());
+		throw std::system_error(err, std::generic_category(), "Failed to move the downloaded file to " + path);
+	}
+	return written;
+}
+
+}
+}
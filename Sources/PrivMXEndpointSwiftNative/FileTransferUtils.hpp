@@ -0,0 +1,189 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef _PRIVMX_ENDPOINT_SWIFT_NATIVE_FileTransferUtils_hpp
+#define _PRIVMX_ENDPOINT_SWIFT_NATIVE_FileTransferUtils_hpp
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "privmx/endpoint/core/Types.hpp"
+
+namespace privmx {
+namespace transfer {
+
+/// Amount of plaintext bytes moved per chunk by the native transfer helpers.
+constexpr int64_t DEFAULT_CHUNK_SIZE = 1024 * 1024;
+
+/// Number of chunks that may wait between the producing and the consuming side of a pipeline.
+constexpr size_t DEFAULT_PIPELINE_DEPTH = 2;
+
+/**
+ * Read-only memory mapping of a file on the local filesystem, unmapped on destruction.
+ *
+ * The mapping is advised for sequential access, so the kernel reads ahead of the consumer.
+ */
+class MappedFile{
+public:
+	explicit MappedFile(const std::string& path);
+	~MappedFile();
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	int64_t size() const { return fileSize; }
+
+	/**
+	 * Passes consecutive parts of the file, at most `chunkSize` bytes each, to `consume`.
+	 *
+	 * The next part is prefetched while the current one is consumed and the pages of consumed parts are released,
+	 * so the resident memory stays bounded by a few chunks regardless of the file size.
+	 */
+	void forEachChunk(int64_t chunkSize, const std::function<void(const char* data, size_t size)>& consume);
+
+	/// Like `forEachChunk()` above, asking `chunkSize` for the size of every part.
+	void forEachChunk(const std::function<int64_t()>& chunkSize, const std::function<void(const char* data, size_t size)>& consume);
+
+private:
+	void advise(int64_t offset, int64_t length, int advice);
+
+	void* mapping = nullptr;
+	int64_t fileSize = 0;
+};
+
+/**
+ * File on the local filesystem opened for writing, truncated on open and closed on destruction.
+ */
+class OutputFile{
+public:
+	explicit OutputFile(const std::string& path);
+	~OutputFile();
+	OutputFile(const OutputFile&) = delete;
+	OutputFile& operator=(const OutputFile&) = delete;
+
+	void write(const char* data, size_t size);
+
+	/// Flushes the written data to the storage device.
+	void sync();
+
+private:
+	int fd = -1;
+};
+
+/**
+ * Bounded FIFO shared between a producer and a consumer thread.
+ *
+ * `push()` blocks while the queue is full, `pop()` blocks while it is empty.
+ * After `close()` both sides are released: `push()` returns `false` and `pop()` drains the remaining items before returning `std::nullopt`.
+ */
+template<typename T>
+class BoundedQueue{
+public:
+	explicit BoundedQueue(size_t capacity) : capacity(capacity == 0 ? 1 : capacity) {}
+
+	bool push(T item){
+		std::unique_lock<std::mutex> lock(mutex);
+		notFull.wait(lock, [this]{ return closed || items.size() < capacity; });
+		if(closed) return false;
+		items.push_back(std::move(item));
+		notEmpty.notify_one();
+		return true;
+	}
+
+	std::optional<T> pop(){
+		std::unique_lock<std::mutex> lock(mutex);
+		notEmpty.wait(lock, [this]{ return closed || !items.empty(); });
+		if(items.empty()) return std::nullopt;
+		T item = std::move(items.front());
+		items.pop_front();
+		notFull.notify_one();
+		return item;
+	}
+
+	void close(){
+		std::lock_guard<std::mutex> lock(mutex);
+		closed = true;
+		notEmpty.notify_all();
+		notFull.notify_all();
+	}
+
+private:
+	const size_t capacity;
+	bool closed = false;
+	std::deque<T> items;
+	std::mutex mutex;
+	std::condition_variable notEmpty;
+	std::condition_variable notFull;
+};
+
+/**
+ * Runs `produce` on a background thread and `consume` on the calling thread, overlapping the two.
+ *
+ * `produce` fills the passed chunk and returns `false` once the source is exhausted.
+ * An exception thrown on either side stops the pipeline and is rethrown to the caller after the background thread has been joined.
+ */
+template<typename Chunk>
+void runPipeline(const std::function<bool(Chunk&)>& produce,
+				 const std::function<void(Chunk&)>& consume,
+				 size_t depth = DEFAULT_PIPELINE_DEPTH){
+	BoundedQueue<Chunk> queue(depth);
+	std::exception_ptr producerError;
+	std::thread producer([&]{
+		try{
+			while(true){
+				Chunk chunk;
+				if(!produce(chunk)) break;
+				if(!queue.push(std::move(chunk))) break;
+			}
+		}catch(...){
+			producerError = std::current_exception();
+		}
+		queue.close();
+	});
+	try{
+		while(auto chunk = queue.pop()){
+			consume(*chunk);
+		}
+	}catch(...){
+		queue.close();
+		producer.join();
+		throw;
+	}
+	producer.join();
+	if(producerError) std::rethrow_exception(producerError);
+}
+
+/**
+ * Streams chunks returned by `readChunk` into a file at `path` until an empty chunk is returned.
+ *
+ * `chunkSize` is asked for the length of every chunk, which is reserved against the transfer memory budget and passed to `readChunk`.
+ * `readChunk` must not return more than that.
+ * Reading the next chunk overlaps with writing the previous one. The data is written to `path` suffixed with `.part`,
+ * which is renamed to `path` on success and removed on failure, so an interrupted download never looks complete.
+ *
+ * @param syncInterval amount of bytes after which the written data is flushed to the storage device, `0` disables syncing
+ * @return number of bytes written
+ */
+int64_t downloadToPath(const std::string& path,
+					   const std::function<int64_t()>& chunkSize,
+					   int64_t syncInterval,
+					   const std::function<endpoint::core::Buffer(int64_t length)>& readChunk);
+
+}
+}
+
+#endif /* _PRIVMX_ENDPOINT_SWIFT_NATIVE_FileTransferUtils_hpp */
@@ -124,6 +124,33 @@ ResultWithError<core::Buffer> NativeCryptoApiWrapper::encryptDataSymmetric(const
 	return res;
 }
 
+ResultWithError<core::Buffer> NativeCryptoApiWrapper::encryptDataSymmetric(const BufferView& data,
+																		   const core::Buffer& symmetricKey){
+	ResultWithError<core::Buffer> res;
+	try {
+		res.result = getapi()->encryptDataSymmetric(core::Buffer::from(data.data, data.size),
+													symmetricKey);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
 ResultWithError<core::Buffer> NativeCryptoApiWrapper::decryptDataSymmetric(const core::Buffer& data,
 																		   const core::Buffer& symmetricKey){
 	ResultWithError<core::Buffer> res;
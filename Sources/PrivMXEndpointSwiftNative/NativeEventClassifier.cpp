@@ -0,0 +1,69 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "NativeEventClassifier.hpp"
+#include "EventClassification.hpp"
+
+namespace privmx {
+
+using namespace endpoint;
+
+ResultWithError<EventType> EventClassifier::classifyEvent(const core::EventHolder& eventHolder){
+	ResultWithError<EventType> res;
+	try{
+		res.result = transfer::classifyEvent(eventHolder);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<std::string> EventClassifier::getEventContainerId(const core::EventHolder& eventHolder){
+	ResultWithError<std::string> res;
+	try{
+		res.result = transfer::eventContainerId(eventHolder, transfer::classifyEvent(eventHolder));
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+}
@@ -0,0 +1,128 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "NativeEventDispatcher.hpp"
+#include "EventDispatcher.hpp"
+
+#include <stdexcept>
+
+namespace privmx {
+
+using namespace endpoint;
+
+ResultWithError<NativeEventDispatcher> NativeEventDispatcher::create(int64_t workerCount){
+	ResultWithError<NativeEventDispatcher> res;
+	try{
+		if(workerCount < 0) throw std::invalid_argument("The number of workers cannot be negative");
+		NativeEventDispatcher result;
+		result.dispatcher = std::make_shared<transfer::EventDispatcher>(static_cast<size_t>(workerCount));
+		res.result = result;
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<int64_t> NativeEventDispatcher::subscribe(EventType eventType,
+														  const std::string& containerId,
+														  EventCallback callback,
+														  void* context,
+														  EventContextRelease release){
+	ResultWithError<int64_t> res;
+	try{
+		res.result = getdispatcher()->subscribe(eventType, containerId, callback, context, release);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<nullptr_t> NativeEventDispatcher::unsubscribe(int64_t subscriptionId){
+	ResultWithError<nullptr_t> res;
+	try{
+		getdispatcher()->unsubscribe(subscriptionId);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<nullptr_t> NativeEventDispatcher::stop(){
+	ResultWithError<nullptr_t> res;
+	try{
+		getdispatcher()->stop();
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+}
@@ -10,6 +10,15 @@
 //
 
 #include "NativeEventQueueWrapper.hpp"
+#include "EventCoalescer.hpp"
+#include "EventFilter.hpp"
+#include "EventPipeline.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
 namespace privmx{
 using namespace endpoint;
 
@@ -45,7 +54,7 @@ ResultWithError<NativeEventQueueWrapper> NativeEventQueueWrapper::getInstance(){
 ResultWithError<core::EventHolder> NativeEventQueueWrapper::waitEvent(){
 	ResultWithError<core::EventHolder> res;
 	try{
-		res.result = getApi()->waitEvent();
+		res.result = *transfer::takeEvent(*getApi(), true);
 		}catch(core::Exception& err){
 		res.error = {
 			.name = err.getName(),
@@ -70,7 +79,55 @@ ResultWithError<core::EventHolder> NativeEventQueueWrapper::waitEvent(){
 ResultWithError<std::optional<core::EventHolder>> NativeEventQueueWrapper::getEvent(){
 	ResultWithError<std::optional<core::EventHolder>> res;
 	try{
-		res.result = getApi()->getEvent();
+		res.result = transfer::takeEvent(*getApi(), false);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<EventHolderVector> NativeEventQueueWrapper::waitEvents(int64_t maxCount, int64_t timeoutMs){
+	ResultWithError<EventHolderVector> res;
+	try{
+		if(maxCount <= 0) throw std::invalid_argument("The maximum number of events must be positive");
+		auto queue = getApi();
+		EventHolderVector events;
+		std::optional<core::EventHolder> event = transfer::takeEvent(*queue, false);
+		if(!event && timeoutMs < 0){
+			event = transfer::takeEvent(*queue, true);
+		}else if(!event && timeoutMs > 0){
+			// The queue has no timed wait, so it is polled with a growing interval.
+			auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+			std::chrono::milliseconds interval{1};
+			while(!(event = transfer::takeEvent(*queue, false))){
+				auto now = std::chrono::steady_clock::now();
+				if(now >= deadline) break;
+				std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(interval, deadline - now));
+				interval = std::min(interval * 2, transfer::EVENT_POLL_MAX_INTERVAL);
+			}
+		}
+		while(event){
+			bool stop = core::Events::isLibBreakEvent(*event);
+			events.push_back(std::move(*event));
+			if(stop || static_cast<int64_t>(events.size()) >= maxCount) break;
+			event = transfer::takeEvent(*queue, false);
+		}
+		res.result = std::move(events);
 		}catch(core::Exception& err){
 		res.error = {
 			.name = err.getName(),
@@ -117,4 +174,105 @@ ResultWithError<nullptr_t> NativeEventQueueWrapper::emitBreakEvent(){
 	return res;
 }
 
+ResultWithError<nullptr_t> NativeEventQueueWrapper::setEventTypeFilter(const EventTypeVector& allowed, const EventTypeVector& denied){
+	ResultWithError<nullptr_t> res;
+	try{
+		transfer::EventFilter::instance().setTypes(allowed, denied);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<nullptr_t> NativeEventQueueWrapper::setContainerFilter(const StringVector& allowed, const StringVector& denied){
+	ResultWithError<nullptr_t> res;
+	try{
+		transfer::EventFilter::instance().setContainers(allowed, denied);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<nullptr_t> NativeEventQueueWrapper::clearEventFilter(){
+	ResultWithError<nullptr_t> res;
+	try{
+		transfer::EventFilter::instance().clear();
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<nullptr_t> NativeEventQueueWrapper::setEventCoalescing(int64_t windowMs){
+	ResultWithError<nullptr_t> res;
+	try{
+		if(windowMs < 0) throw std::invalid_argument("The coalescing window cannot be negative");
+		transfer::EventCoalescer::instance().setWindow(std::chrono::milliseconds(windowMs));
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
 }
@@ -10,12 +10,29 @@
 //
 
 #include "NativeInboxApiWrapper.hpp"
+#include "FileHandleRegistry.hpp"
+#include "AsyncFileWriter.hpp"
+#include "FileTransferUtils.hpp"
+#include "TransferMemoryBudget.hpp"
+#include "ChunkBufferPool.hpp"
+#include "ChunkSizeTuner.hpp"
+#include "Sha256Digest.hpp"
+
+#include <stdexcept>
 
 namespace privmx {
 using namespace endpoint;
 
 NativeInboxApiWrapper::NativeInboxApiWrapper(std::shared_ptr<inbox::InboxApi> _api){
 	api = _api;
+	handles = std::make_shared<transfer::FileHandleRegistry>(transfer::FileReadOps{
+		.read = [_api](int64_t handle, int64_t length){ return _api->readFromFile(handle, length); },
+		.seek = [_api](int64_t handle, int64_t position){ _api->seekInFile(handle, position); }
+	}, transfer::HandleOps{
+		.open = [_api](const std::string& fileId){ return _api->openFile(fileId); },
+		.close = [_api](int64_t handle){ _api->closeFile(handle); }
+	});
+	writer = std::make_shared<transfer::AsyncFileWriter>();
 }
 
 ResultWithError<NativeInboxApiWrapper> NativeInboxApiWrapper::create(NativeConnectionWrapper &connection,
@@ -260,9 +277,41 @@ ResultWithError<InboxHandle> NativeInboxApiWrapper::prepareEntry(const std::stri
 }
 
 
+ResultWithError<InboxHandle> NativeInboxApiWrapper::prepareEntry(const std::string& inboxId,
+																 const BufferView& data,
+																 const InboxFileHandleVector& inboxFileHandles,
+																 const OptionalString& userPrivKey){
+	ResultWithError<InboxHandle> res;
+	try {
+		res.result = getapi()->prepareEntry(inboxId,
+											core::Buffer::from(data.data, data.size),
+											inboxFileHandles,
+											userPrivKey);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
 ResultWithError<nullptr_t> NativeInboxApiWrapper::sendEntry(const InboxHandle inboxHandle){
 	ResultWithError<nullptr_t> res;
 	try {
+		getwriter()->flush(inboxHandle);
 		getapi()->sendEntry(inboxHandle);
 		}catch(core::Exception& err){
 		res.error = {
@@ -396,9 +445,90 @@ ResultWithError<nullptr_t> NativeInboxApiWrapper::writeToFile(const InboxHandle
 															  const endpoint::core::Buffer& dataChunk){
 	ResultWithError<nullptr_t> res;
 	try {
-		getapi()->writeToFile(inboxHandle,
-							  inboxFileHandle,
-							  dataChunk);
+		write(inboxHandle, inboxFileHandle, dataChunk);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<nullptr_t> NativeInboxApiWrapper::writeToFile(const InboxHandle inboxHandle,
+															  const InboxFileHandle inboxFileHandle,
+															  const BufferView& dataChunk){
+	ResultWithError<nullptr_t> res;
+	try {
+		write(inboxHandle, inboxFileHandle, transfer::ChunkBufferPool::instance().copyToBuffer(dataChunk.data, dataChunk.size));
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<nullptr_t> NativeInboxApiWrapper::writeFileFromPath(const InboxHandle inboxHandle,
+																	const InboxFileHandle inboxFileHandle,
+																	const std::string& filePath){
+	ResultWithError<nullptr_t> res;
+	try {
+		writeFromPath(inboxHandle, inboxFileHandle, filePath, nullptr);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<FileDigest> NativeInboxApiWrapper::writeFileFromPathWithDigest(const InboxHandle inboxHandle,
+																			   const InboxFileHandle inboxFileHandle,
+																			   const std::string& filePath){
+	ResultWithError<FileDigest> res;
+	try {
+		transfer::Sha256Digest digest;
+		writeFromPath(inboxHandle, inboxFileHandle, filePath, &digest);
+		res.result = FileDigest{.size = digest.size(), .sha256 = digest.hex()};
 		}catch(core::Exception& err){
 		res.error = {
 			.name = err.getName(),
@@ -424,6 +554,7 @@ ResultWithError<InboxFileHandle> NativeInboxApiWrapper::openFile(const std::stri
 	ResultWithError<InboxFileHandle> res;
 	try {
 		res.result = getapi()->openFile(fileId);
+		gethandles()->opened(*res.result, fileId);
 		}catch(core::Exception& err){
 		res.error = {
 			.name = err.getName(),
@@ -449,8 +580,38 @@ ResultWithError<core::Buffer> NativeInboxApiWrapper::readFromFile(const InboxFil
 																  const int64_t length){
 	ResultWithError<core::Buffer> res;
 	try {
-		res.result = getapi()->readFromFile(fileHandle,
-											length);
+		res.result = gethandles()->read(fileHandle,
+										length);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<int64_t> NativeInboxApiWrapper::readFromFileInto(const InboxFileHandle fileHandle,
+																 void* dst,
+																 size_t capacity){
+	ResultWithError<int64_t> res;
+	try {
+		if(!dst && capacity > 0) throw std::invalid_argument("The destination is null");
+		res.result = gethandles()->readInto(fileHandle,
+											static_cast<char*>(dst),
+											static_cast<int64_t>(capacity));
 		}catch(core::Exception& err){
 		res.error = {
 			.name = err.getName(),
@@ -476,8 +637,111 @@ ResultWithError<nullptr_t> NativeInboxApiWrapper::seekInFile(const InboxFileHand
 															 const int64_t position){
 	ResultWithError<nullptr_t> res;
 	try {
-		getapi()->seekInFile(fileHandle,
-							 position);
+		gethandles()->seek(fileHandle,
+						   position);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<core::Buffer> NativeInboxApiWrapper::readRange(const std::string& fileId,
+															   int64_t offset,
+															   int64_t length){
+	ResultWithError<core::Buffer> res;
+	try {
+		res.result = gethandles()->readRange(fileId, offset, length);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<nullptr_t> NativeInboxApiWrapper::setBlockCacheSize(int64_t bytes){
+	ResultWithError<nullptr_t> res;
+	try {
+		gethandles()->setBlockCacheSize(bytes);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<nullptr_t> NativeInboxApiWrapper::setFileHandleLabel(const InboxFileHandle fileHandle,
+																	 const std::string& label){
+	ResultWithError<nullptr_t> res;
+	try {
+		gethandles()->label(fileHandle, label);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<LiveFileHandleVector> NativeInboxApiWrapper::getLiveFileHandles(){
+	ResultWithError<LiveFileHandleVector> res;
+	try {
+		res.result = gethandles()->live();
 		}catch(core::Exception& err){
 		res.error = {
 			.name = err.getName(),
@@ -502,6 +766,7 @@ ResultWithError<nullptr_t> NativeInboxApiWrapper::seekInFile(const InboxFileHand
 ResultWithError<std::string> NativeInboxApiWrapper::closeFile(const InboxFileHandle fileHandle){
 	ResultWithError<std::string> res;
 	try {
+		gethandles()->release(fileHandle);
 		res.result = getapi()->closeFile(fileHandle);
 		}catch(core::Exception& err){
 		res.error = {
@@ -524,6 +789,180 @@ ResultWithError<std::string> NativeInboxApiWrapper::closeFile(const InboxFileHan
 	return res;
 }
 
+ResultWithError<nullptr_t> NativeInboxApiWrapper::enableFileDigest(const InboxFileHandle fileHandle){
+	ResultWithError<nullptr_t> res;
+	try {
+		gethandles()->enableDigest(fileHandle);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<FileDigest> NativeInboxApiWrapper::closeFileWithDigest(const InboxFileHandle fileHandle){
+	ResultWithError<FileDigest> res;
+	try {
+		auto digest = gethandles()->digest(fileHandle);
+		if(!digest) throw std::logic_error("The digest was not enabled for the handle");
+		gethandles()->release(fileHandle);
+		digest->fileId = getapi()->closeFile(fileHandle);
+		res.result = *digest;
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<int64_t> NativeInboxApiWrapper::downloadFileToPath(const std::string& fileId,
+																   const std::string& filePath,
+																   int64_t syncInterval){
+	ResultWithError<int64_t> res;
+	try {
+		res.result = downloadToPath(fileId, filePath, syncInterval, nullptr);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<FileDigest> NativeInboxApiWrapper::downloadFileToPathWithDigest(const std::string& fileId,
+																				const std::string& filePath,
+																				int64_t syncInterval){
+	ResultWithError<FileDigest> res;
+	try {
+		transfer::Sha256Digest digest;
+		downloadToPath(fileId, filePath, syncInterval, &digest);
+		res.result = FileDigest{.fileId = fileId, .size = digest.size(), .sha256 = digest.hex()};
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+void NativeInboxApiWrapper::write(const InboxHandle inboxHandle,
+								  const InboxFileHandle inboxFileHandle,
+								  const core::Buffer& chunk){
+	auto inboxApi = getapi();
+	auto writer = getwriter();
+	auto reservation = transfer::TransferMemoryBudget::instance().reserve(chunk.size());
+	if(writer->enabled()){
+		// Writes of all files of an entry share its worker, which keeps them in order.
+		writer->submit(inboxHandle, std::move(reservation), [inboxApi, inboxHandle, inboxFileHandle, chunk]{
+			inboxApi->writeToFile(inboxHandle, inboxFileHandle, chunk);
+		});
+	}else{
+		writer->flush(inboxHandle);
+		inboxApi->writeToFile(inboxHandle, inboxFileHandle, chunk);
+	}
+}
+
+void NativeInboxApiWrapper::writeFromPath(const InboxHandle inboxHandle,
+										  const InboxFileHandle inboxFileHandle,
+										  const std::string& filePath,
+										  transfer::Sha256Digest* digest){
+	auto inboxApi = getapi();
+	// Chunks queued by `writeToFile()` precede the content of the path.
+	getwriter()->flush(inboxHandle);
+	transfer::MappedFile source(filePath);
+	auto& tuner = transfer::ChunkSizeTuner::uploads();
+	source.forEachChunk([&]{ return tuner.chunkSize(); }, [&](const char* data, size_t size){
+		auto reservation = transfer::TransferMemoryBudget::instance().reserve(size);
+		tuner.measure(size, [&]{
+			inboxApi->writeToFile(inboxHandle, inboxFileHandle, transfer::ChunkBufferPool::instance().copyToBuffer(data, size));
+			return size;
+		});
+		if(digest) digest->update(data, size);
+	});
+}
+
+int64_t NativeInboxApiWrapper::downloadToPath(const std::string& fileId,
+											  const std::string& filePath,
+											  int64_t syncInterval,
+											  transfer::Sha256Digest* digest){
+	auto inboxApi = getapi();
+	InboxFileHandle handle = inboxApi->openFile(fileId);
+	int64_t written;
+	try{
+		auto& tuner = transfer::ChunkSizeTuner::downloads();
+		written = transfer::downloadToPath(filePath, [&]{ return tuner.chunkSize(); }, syncInterval, [&](int64_t length){
+			core::Buffer chunk;
+			tuner.measure(length, [&]{
+				chunk = inboxApi->readFromFile(handle, length);
+				return chunk.size();
+			});
+			if(digest) digest->update(chunk.data(), chunk.size());
+			return chunk;
+		});
+	}catch(...){
+		try{
+			inboxApi->closeFile(handle);
+		}catch(...){}
+		throw;
+	}
+	inboxApi->closeFile(handle);
+	return written;
+}
+
 ResultWithError<nullptr_t> NativeInboxApiWrapper::subscribeForInboxEvents(){
 	ResultWithError<nullptr_t> res;
 	try {
@@ -599,6 +1038,31 @@ ResultWithError<nullptr_t> NativeInboxApiWrapper::subscribeForEntryEvents(const
 	return res;
 }
 
+ResultWithError<nullptr_t> NativeInboxApiWrapper::setAsyncWrites(bool enabled){
+	ResultWithError<nullptr_t> res;
+	try{
+		getwriter()->setEnabled(enabled);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
 ResultWithError<nullptr_t> NativeInboxApiWrapper::unsubscribeFromEntryEvents(const std::string& inboxId){
 	ResultWithError<nullptr_t> res;
 	try {
@@ -10,6 +10,23 @@
 //
 
 #include "NativeStoreApiWrapper.hpp"
+#include "FileHandleRegistry.hpp"
+#include "AsyncFileWriter.hpp"
+#include "EventObservers.hpp"
+#include "DedupIndex.hpp"
+#include "FileCompression.hpp"
+#include "FileTransferUtils.hpp"
+#include "TransferMemoryBudget.hpp"
+#include "ChunkBufferPool.hpp"
+#include "ChunkSizeTuner.hpp"
+#include "Sha256Digest.hpp"
+#include "UploadRecord.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <system_error>
 
 namespace privmx {
 
@@ -17,6 +34,36 @@ using namespace endpoint;
 
 NativeStoreApiWrapper::NativeStoreApiWrapper(NativeConnectionWrapper& connection){
 	api = std::make_shared<store::StoreApi>(store::StoreApi::create(*(connection.getApi())));
+	auto storeApi = api;
+	handles = std::make_shared<transfer::FileHandleRegistry>(transfer::FileReadOps{
+		.read = [storeApi](int64_t handle, int64_t length){ return storeApi->readFromFile(handle, length); },
+		.seek = [storeApi](int64_t handle, int64_t position){ storeApi->seekInFile(handle, position); },
+		.size = [storeApi](const std::string& fileId){ return storeApi->getFile(fileId).size; }
+	}, transfer::HandleOps{
+		.open = [storeApi](const std::string& fileId){ return storeApi->openFile(fileId); },
+		.close = [storeApi](int64_t handle){ storeApi->closeFile(handle); }
+	});
+	dedup = std::make_shared<transfer::DedupIndex>();
+	writer = std::make_shared<transfer::AsyncFileWriter>();
+	// Changes made by other clients arrive as events, pooled handles, cached blocks and index entries of such Files are dropped.
+	std::weak_ptr<transfer::FileHandleRegistry> weakHandles = handles;
+	std::weak_ptr<transfer::DedupIndex> weakDedup = dedup;
+	transfer::EventObservers::instance().add(handles, [weakHandles, weakDedup](const core::EventHolder& event){
+		auto registry = weakHandles.lock();
+		auto index = weakDedup.lock();
+		if(!registry || !index) return;
+		if(store::Events::isStoreFileUpdatedEvent(event)){
+			std::string fileId = store::Events::extractStoreFileUpdatedEvent(event).data.info.fileId;
+			registry->invalidate(fileId);
+			index->remove(fileId);
+		}else if(store::Events::isStoreFileDeletedEvent(event)){
+			std::string fileId = store::Events::extractStoreFileDeletedEvent(event).data.fileId;
+			registry->invalidate(fileId);
+			index->remove(fileId);
+		}else if(store::Events::isStoreDeletedEvent(event)){
+			index->removeStore(store::Events::extractStoreDeletedEvent(event).data.storeId);
+		}
+	});
 }
 
 ResultWithError<NativeStoreApiWrapper> NativeStoreApiWrapper::create(NativeConnectionWrapper &connection){
@@ -229,6 +276,7 @@ ResultWithError<StoreFileHandle> NativeStoreApiWrapper::createFile(const std::st
 	ResultWithError<StoreFileHandle> res;
 	try{
 		res.result = getapi()->createFile(storeId, publicMeta, privateMeta, size);
+		gethandles()->creating(*res.result);
 		}catch(core::Exception& err){
 		res.error = {
 			.name = err.getName(),
@@ -257,6 +305,7 @@ ResultWithError<StoreFileHandle> NativeStoreApiWrapper::updateFile(const std::st
 	ResultWithError<StoreFileHandle> res;
 	try{
 		res.result = getapi()->updateFile(fileId, publicMeta, privateMeta, size);
+		gethandles()->updating(*res.result, fileId);
 		}catch(core::Exception& err){
 		res.error = {
 			.name = err.getName(),
@@ -308,7 +357,7 @@ ResultWithError<std::nullptr_t> NativeStoreApiWrapper::updateFileMeta(const std:
 ResultWithError<StoreFileHandle> NativeStoreApiWrapper::openFile(const std::string& fileId){
 	ResultWithError<StoreFileHandle> res;
 	try{
-		res.result = getapi()->openFile(fileId);
+		res.result = gethandles()->open(fileId);
 		}catch(core::Exception& err){
 		res.error = {
 			.name = err.getName(),
@@ -334,7 +383,35 @@ ResultWithError<core::Buffer> NativeStoreApiWrapper::readFromFile(StoreFileHandl
 																			int64_t length){
 	ResultWithError<core::Buffer> res;
 	try{
-		res.result = getapi()->readFromFile(handle,length);
+		res.result = gethandles()->read(handle,length);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<int64_t> NativeStoreApiWrapper::readFromFileInto(StoreFileHandle handle,
+																 void* dst,
+																 size_t capacity){
+	ResultWithError<int64_t> res;
+	try{
+		if(!dst && capacity > 0) throw std::invalid_argument("The destination is null");
+		res.result = gethandles()->readInto(handle, static_cast<char*>(dst), static_cast<int64_t>(capacity));
 		}catch(core::Exception& err){
 		res.error = {
 			.name = err.getName(),
@@ -360,7 +437,33 @@ ResultWithError<std::nullptr_t> NativeStoreApiWrapper::writeToFile(StoreFileHand
 																   const core::Buffer& dataChunk){
 	ResultWithError<std::nullptr_t> res;
 	try{
-		getapi()->writeToFile(handle, dataChunk);
+		write(handle, dataChunk);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<std::nullptr_t> NativeStoreApiWrapper::writeToFile(StoreFileHandle handle,
+																   const BufferView& dataChunk){
+	ResultWithError<std::nullptr_t> res;
+	try{
+		write(handle, transfer::ChunkBufferPool::instance().copyToBuffer(dataChunk.data, dataChunk.size));
 		}catch(core::Exception& err){
 		res.error = {
 			.name = err.getName(),
@@ -386,6 +489,8 @@ ResultWithError<std::nullptr_t> NativeStoreApiWrapper::deleteFile(const std::str
 	ResultWithError<std::nullptr_t> res;
 	try{
 		getapi()->deleteFile(fileId);
+		gethandles()->invalidate(fileId);
+		getdedup()->remove(fileId);
 		}catch(core::Exception& err){
 		res.error = {
 			.name = err.getName(),
@@ -407,11 +512,68 @@ ResultWithError<std::nullptr_t> NativeStoreApiWrapper::deleteFile(const std::str
 	return res;
 }
 
-ResultWithError<std::nullptr_t> NativeStoreApiWrapper::seekInFile(StoreFileHandle handle,
-																	 int64_t position){
+ResultWithError<std::string> NativeStoreApiWrapper::uploadFile(const std::string& storeId,
+															   const core::Buffer& publicMeta,
+															   const core::Buffer& privateMeta,
+															   const std::string& filePath){
+	ResultWithError<std::string> res;
+	try{
+		res.result = uploadFromPath(storeId, publicMeta, privateMeta, filePath, nullptr);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<FileDigest> NativeStoreApiWrapper::uploadFileWithDigest(const std::string& storeId,
+																		const core::Buffer& publicMeta,
+																		const core::Buffer& privateMeta,
+																		const std::string& filePath){
+	ResultWithError<FileDigest> res;
+	try{
+		transfer::Sha256Digest digest;
+		std::string fileId = uploadFromPath(storeId, publicMeta, privateMeta, filePath, nullptr, &digest);
+		res.result = FileDigest{.fileId = fileId, .size = digest.size(), .sha256 = digest.hex()};
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<std::nullptr_t> NativeStoreApiWrapper::enableUploadDeduplication(const std::string& indexPath){
 	ResultWithError<std::nullptr_t> res;
 	try{
-		getapi()->seekInFile(handle, position);
+		getdedup()->enable(indexPath);
 		}catch(core::Exception& err){
 		res.error = {
 			.name = err.getName(),
@@ -433,10 +595,819 @@ ResultWithError<std::nullptr_t> NativeStoreApiWrapper::seekInFile(StoreFileHandl
 	return res;
 }
 
-ResultWithError<std::string> NativeStoreApiWrapper::closeFile(StoreFileHandle handle){
+ResultWithError<std::nullptr_t> NativeStoreApiWrapper::disableUploadDeduplication(){
+	ResultWithError<std::nullptr_t> res;
+	try{
+		getdedup()->disable();
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<std::string> NativeStoreApiWrapper::uploadFileCompressed(const std::string& storeId,
+																		 const core::Buffer& publicMeta,
+																		 const core::Buffer& privateMeta,
+																		 const std::string& filePath,
+																		 int64_t level){
+	ResultWithError<std::string> res;
+	try{
+		if(level < 1 || level > 9) throw std::invalid_argument("The compression level must be between 1 and 9");
+		auto storeApi = getapi();
+		transfer::MappedFile source(filePath);
+		// Frame sizes are only known once the whole content is deflated, and the table precedes the frames.
+		transfer::TemporaryFile frames;
+		transfer::CompressedLayout layout;
+		{
+			transfer::OutputFile out(frames.path());
+			layout = transfer::compressFile(source, out, level);
+		}
+		const std::string header = transfer::encodeCompressedHeader(layout);
+		transfer::MappedFile compressed(frames.path());
+		res.result = uploadContent(storeId, publicMeta, privateMeta, header.size() + compressed.size(), [&](StoreFileHandle handle){
+			storeApi->writeToFile(handle, core::Buffer::from(header.data(), header.size()));
+			auto& tuner = transfer::ChunkSizeTuner::uploads();
+			compressed.forEachChunk([&]{ return tuner.chunkSize(); }, [&](const char* data, size_t size){
+				auto reservation = transfer::TransferMemoryBudget::instance().reserve(size);
+				tuner.measure(size, [&]{
+					storeApi->writeToFile(handle, transfer::ChunkBufferPool::instance().copyToBuffer(data, size));
+					return size;
+				});
+			});
+		});
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<std::nullptr_t> NativeStoreApiWrapper::setTransparentDecompression(bool enabled){
+	ResultWithError<std::nullptr_t> res;
+	try{
+		gethandles()->setDecompression(enabled);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<std::string> NativeStoreApiWrapper::uploadFile(const std::string& storeId,
+															   const core::Buffer& publicMeta,
+															   const core::Buffer& privateMeta,
+															   int64_t size,
+															   ChunkReaderCallback reader,
+															   void* context){
+	ResultWithError<std::string> res;
+	try{
+		if(!reader) throw std::invalid_argument("The chunk reader is null");
+		res.result = uploadContent(storeId,
+								   publicMeta,
+								   privateMeta,
+								   size,
+								   [this, size, reader, context](StoreFileHandle handle){
+			pipelinedWrite(handle, size, [reader, context](char* buffer, int64_t capacity){
+				return reader(context, buffer, capacity);
+			});
+		});
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<std::string> NativeStoreApiWrapper::uploadFileRecorded(const std::string& storeId,
+																	   const core::Buffer& publicMeta,
+																	   const core::Buffer& privateMeta,
+																	   const std::string& filePath,
+																	   const std::string& recordPath){
 	ResultWithError<std::string> res;
 	try{
-		res.result = getapi()->closeFile(handle);
+		auto storeApi = getapi();
+		struct stat info;
+		if(::stat(filePath.c_str(), &info) != 0){
+			throw std::system_error(errno, std::generic_category(), "Failed to stat " + filePath);
+		}
+		transfer::MappedFile source(filePath);
+		auto previous = transfer::loadUploadRecord(recordPath);
+		if(previous && !previous->fileId.empty()
+		   && previous->storeId == storeId
+		   && previous->filePath == filePath
+		   && previous->fileSize == source.size()
+		   && previous->modificationTime == info.st_mtime
+		   && isRecordedFile(*previous)){
+			transfer::Sha256Digest digest;
+			source.forEachChunk(transfer::DEFAULT_CHUNK_SIZE, [&](const char* data, size_t size){
+				digest.update(data, size);
+			});
+			if(digest.hex() == previous->sha256){
+				res.result = previous->fileId;
+				return res;
+			}
+		}
+		UploadRecord record{
+			.storeId = storeId,
+			.filePath = filePath,
+			.fileSize = source.size(),
+			.modificationTime = info.st_mtime
+		};
+		transfer::saveUploadRecord(recordPath, record);
+		transfer::Sha256Digest digest;
+		std::string verifier = transfer::DedupIndex::verifierOf(nullptr, 0);
+		record.fileId = uploadContent(storeId, publicMeta, privateMeta, source.size(), [&](StoreFileHandle handle){
+			auto& tuner = transfer::ChunkSizeTuner::uploads();
+			source.forEachChunk([&]{ return tuner.chunkSize(); }, [&](const char* data, size_t size){
+				auto reservation = transfer::TransferMemoryBudget::instance().reserve(size);
+				tuner.measure(size, [&]{
+					storeApi->writeToFile(handle, transfer::ChunkBufferPool::instance().copyToBuffer(data, size));
+					return size;
+				});
+				if(digest.size() == 0) verifier = transfer::DedupIndex::verifierOf(data, size);
+				digest.update(data, size);
+			});
+		});
+		record.sha256 = digest.hex();
+		// The File exists from here on, reporting a failure would make the caller upload it again.
+		try{
+			transfer::saveUploadRecord(recordPath, record);
+			getdedup()->add(storeId, record.sha256, record.fileId, verifier);
+		}catch(...){}
+		res.result = record.fileId;
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<std::optional<UploadRecord>> NativeStoreApiWrapper::readUploadRecord(const std::string& recordPath){
+	ResultWithError<std::optional<UploadRecord>> res;
+	try{
+		res.result = transfer::loadUploadRecord(recordPath);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<int64_t> NativeStoreApiWrapper::downloadFileToPath(const std::string& fileId,
+																   const std::string& filePath,
+																   int64_t syncInterval){
+	ResultWithError<int64_t> res;
+	try{
+		res.result = downloadToPath(fileId, filePath, syncInterval, nullptr);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<FileDigest> NativeStoreApiWrapper::downloadFileToPathWithDigest(const std::string& fileId,
+																				const std::string& filePath,
+																				int64_t syncInterval){
+	ResultWithError<FileDigest> res;
+	try{
+		transfer::Sha256Digest digest;
+		downloadToPath(fileId, filePath, syncInterval, nullptr, &digest);
+		res.result = FileDigest{.fileId = fileId, .size = digest.size(), .sha256 = digest.hex()};
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+std::string NativeStoreApiWrapper::uploadFromPath(const std::string& storeId,
+												  const core::Buffer& publicMeta,
+												  const core::Buffer& privateMeta,
+												  const std::string& filePath,
+												  const std::function<void(int64_t)>& progress,
+												  transfer::Sha256Digest* digest){
+	auto storeApi = getapi();
+	auto index = getdedup();
+	transfer::MappedFile source(filePath);
+	std::optional<std::string> sha256;
+	std::string verifier = transfer::DedupIndex::verifierOf(nullptr, 0);
+	if(index->enabled()){
+		// The content has to be known before anything is sent, which costs one local pass over the source.
+		transfer::Sha256Digest contentDigest;
+		transfer::Sha256Digest& target = digest ? *digest : contentDigest;
+		source.forEachChunk(transfer::DEFAULT_CHUNK_SIZE, [&](const char* data, size_t size){
+			if(target.size() == 0) verifier = transfer::DedupIndex::verifierOf(data, size);
+			target.update(data, size);
+		});
+		sha256 = target.hex();
+		digest = nullptr;
+		if(auto fileId = findDuplicate(storeId, publicMeta, privateMeta, source.size(), *sha256)){
+			if(progress) progress(source.size());
+			return *fileId;
+		}
+	}
+	auto& tuner = transfer::ChunkSizeTuner::uploads();
+	std::string fileId = uploadContent(storeId, publicMeta, privateMeta, source.size(), [&](StoreFileHandle handle){
+		source.forEachChunk([&]{ return tuner.chunkSize(); }, [&](const char* data, size_t size){
+			auto reservation = transfer::TransferMemoryBudget::instance().reserve(size);
+			tuner.measure(size, [&]{
+				storeApi->writeToFile(handle, transfer::ChunkBufferPool::instance().copyToBuffer(data, size));
+				return size;
+			});
+			// The chunk is still mapped here, so hashing it costs no extra read of the file.
+			if(digest) digest->update(data, size);
+			if(progress) progress(size);
+		});
+	});
+	if(sha256) index->add(storeId, *sha256, fileId, verifier);
+	return fileId;
+}
+
+bool NativeStoreApiWrapper::isRecordedFile(const UploadRecord& record){
+	store::File file;
+	try{
+		file = getapi()->getFile(record.fileId);
+	}catch(const core::Exception&){
+		// Deleted since it was recorded, or no longer accessible.
+		return false;
+	}
+	return file.info.storeId == record.storeId && file.size == record.fileSize;
+}
+
+std::optional<std::string> NativeStoreApiWrapper::findDuplicate(const std::string& storeId,
+																const core::Buffer& publicMeta,
+																const core::Buffer& privateMeta,
+																int64_t size,
+																const std::string& sha256){
+	auto storeApi = getapi();
+	auto index = getdedup();
+	for(const auto& [fileId, verifier] : index->find(storeId, sha256)){
+		store::File file;
+		try{
+			file = storeApi->getFile(fileId);
+		}catch(const core::Exception&){
+			// Deleted while no events were received, or no longer accessible.
+			index->remove(fileId);
+			continue;
+		}
+		// Only a File indistinguishable from the new one can stand in for it.
+		if(file.size != size
+		   || file.publicMeta.stdString() != publicMeta.stdString()
+		   || file.privateMeta.stdString() != privateMeta.stdString()){
+			continue;
+		}
+		// The content may have been replaced by an update of the same size while no events were received,
+		// so the leading part of the stored File is compared with the one recorded when it was added.
+		core::Buffer prefix;
+		try{
+			StoreFileHandle handle = storeApi->openFile(fileId);
+			try{
+				prefix = storeApi->readFromFile(handle, std::min(size, transfer::DEDUP_VERIFIED_PREFIX));
+			}catch(...){
+				try{
+					storeApi->closeFile(handle);
+				}catch(...){}
+				throw;
+			}
+			storeApi->closeFile(handle);
+		}catch(const core::Exception&){
+			continue;
+		}
+		if(transfer::DedupIndex::verifierOf(prefix.data(), prefix.size()) == verifier){
+			return fileId;
+		}
+		index->remove(fileId);
+	}
+	return std::nullopt;
+}
+
+int64_t NativeStoreApiWrapper::downloadToPath(const std::string& fileId,
+											  const std::string& filePath,
+											  int64_t syncInterval,
+											  const std::function<void(int64_t)>& progress,
+											  transfer::Sha256Digest* digest){
+	auto storeApi = getapi();
+	auto handles = gethandles();
+	StoreFileHandle handle = storeApi->openFile(fileId);
+	int64_t written;
+	try{
+		auto layout = handles->detectLayout(fileId, handle);
+		size_t frameIndex = 0;
+		auto& tuner = transfer::ChunkSizeTuner::downloads();
+		// Compressed Files are read a frame at a time, so only plain reads are measured.
+		auto chunkSize = [&]{ return layout ? layout->frameSize : tuner.chunkSize(); };
+		written = transfer::downloadToPath(filePath, chunkSize, syncInterval, [&](int64_t length){
+			core::Buffer chunk;
+			if(!layout){
+				tuner.measure(length, [&]{
+					chunk = storeApi->readFromFile(handle, length);
+					return chunk.size();
+				});
+			}else if(frameIndex < layout->frameSizes.size()){
+				transfer::PooledBuffer frame = transfer::ChunkBufferPool::instance().acquire(layout->frameLength(frameIndex));
+				// The pipeline has already reserved the chunk, which covers the stored frame.
+				handles->readFrame(*layout, handle, frameIndex++, frame.data(), true);
+				chunk = transfer::ChunkBufferPool::instance().copyToBuffer(frame.data(), frame.size());
+			}
+			// Chunks are read in order, so the digest is updated on the reading side of the pipeline.
+			if(digest) digest->update(chunk.data(), chunk.size());
+			if(progress) progress(chunk.size());
+			return chunk;
+		});
+	}catch(...){
+		try{
+			storeApi->closeFile(handle);
+		}catch(...){}
+		throw;
+	}
+	storeApi->closeFile(handle);
+	return written;
+}
+
+std::string NativeStoreApiWrapper::uploadContent(const std::string& storeId,
+												 const core::Buffer& publicMeta,
+												 const core::Buffer& privateMeta,
+												 int64_t size,
+												 const std::function<void(StoreFileHandle)>& writeContent){
+	auto storeApi = getapi();
+	StoreFileHandle handle = storeApi->createFile(storeId, publicMeta, privateMeta, size);
+	try{
+		writeContent(handle);
+	}catch(...){
+		try{
+			storeApi->closeFile(handle);
+		}catch(...){}
+		throw;
+	}
+	return storeApi->closeFile(handle);
+}
+
+void NativeStoreApiWrapper::pipelinedWrite(StoreFileHandle handle,
+										   int64_t size,
+										   const std::function<int64_t(char*, int64_t)>& read){
+	auto storeApi = getapi();
+	int64_t remaining = size;
+	auto& tuner = transfer::ChunkSizeTuner::uploads();
+	struct Chunk{
+		transfer::PooledBuffer data;
+		transfer::MemoryReservation reservation;
+		int64_t requested = 0;
+	};
+	transfer::runPipeline<Chunk>(
+		[&](Chunk& chunk){
+			if(remaining <= 0) return false;
+			int64_t size = std::min(remaining, tuner.chunkSize());
+			chunk.reservation = transfer::TransferMemoryBudget::instance().reserve(size);
+			chunk.data = transfer::ChunkBufferPool::instance().acquire(size);
+			chunk.requested = size;
+			int64_t n = read(chunk.data.data(), chunk.data.size());
+			if(n < 0) throw std::runtime_error("The chunk reader reported a failure");
+			if(n == 0) throw std::runtime_error("The source ended before the declared file size");
+			chunk.data.resize(n);
+			remaining -= n;
+			return true;
+		},
+		[&](Chunk& chunk){
+			tuner.measure(chunk.requested, [&]{
+				storeApi->writeToFile(handle, transfer::ChunkBufferPool::instance().copyToBuffer(chunk.data.data(), chunk.data.size()));
+				return chunk.data.size();
+			});
+		});
+}
+
+void NativeStoreApiWrapper::write(StoreFileHandle handle, const core::Buffer& chunk){
+	auto storeApi = getapi();
+	auto writer = getwriter();
+	auto handles = gethandles();
+	auto reservation = transfer::TransferMemoryBudget::instance().reserve(chunk.size());
+	if(writer->enabled()){
+		// The queued copy outlives the caller's buffer. It is hashed only once written, a dropped chunk is not in the content.
+		writer->submit(handle, std::move(reservation), [storeApi, handles, handle, chunk]{
+			storeApi->writeToFile(handle, chunk);
+			handles->written(handle, chunk.data(), chunk.size());
+		});
+	}else{
+		// Chunks queued before the mode was turned off have to land first.
+		writer->flush(handle);
+		storeApi->writeToFile(handle, chunk);
+		handles->written(handle, chunk.data(), chunk.size());
+	}
+}
+
+std::string NativeStoreApiWrapper::closeHandle(StoreFileHandle handle){
+	auto handles = gethandles();
+	try{
+		getwriter()->flush(handle);
+	}catch(...){
+		// The content is incomplete, but the handle must not leak.
+		handles->release(handle);
+		try{
+			getapi()->closeFile(handle);
+		}catch(...){}
+		throw;
+	}
+	if(auto fileId = handles->recycle(handle)){
+		return *fileId;
+	}
+	std::string updatedFileId = handles->release(handle);
+	std::string fileId = getapi()->closeFile(handle);
+	if(!updatedFileId.empty()){
+		handles->invalidate(updatedFileId);
+		getdedup()->remove(updatedFileId);
+	}
+	return fileId;
+}
+
+ResultWithError<std::nullptr_t> NativeStoreApiWrapper::seekInFile(StoreFileHandle handle,
+																	 int64_t position){
+	ResultWithError<std::nullptr_t> res;
+	try{
+		gethandles()->seek(handle, position);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<core::Buffer> NativeStoreApiWrapper::readRange(const std::string& fileId,
+															   int64_t offset,
+															   int64_t length){
+	ResultWithError<core::Buffer> res;
+	try{
+		res.result = gethandles()->readRange(fileId, offset, length);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<std::nullptr_t> NativeStoreApiWrapper::setReadAheadDepth(int64_t chunkCount){
+	ResultWithError<std::nullptr_t> res;
+	try{
+		if(chunkCount < 0) throw std::invalid_argument("The read-ahead depth cannot be negative");
+		gethandles()->setReadAheadDepth(static_cast<size_t>(chunkCount));
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<std::nullptr_t> NativeStoreApiWrapper::setBlockCacheSize(int64_t bytes){
+	ResultWithError<std::nullptr_t> res;
+	try{
+		gethandles()->setBlockCacheSize(bytes);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<std::nullptr_t> NativeStoreApiWrapper::setAsyncWrites(bool enabled){
+	ResultWithError<std::nullptr_t> res;
+	try{
+		getwriter()->setEnabled(enabled);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<std::nullptr_t> NativeStoreApiWrapper::setOpenHandlePoolLimits(int64_t maxIdleHandles,
+																				 int64_t idleTimeoutMs){
+	ResultWithError<std::nullptr_t> res;
+	try{
+		if(maxIdleHandles < 0 || idleTimeoutMs < 0) throw std::invalid_argument("Handle pool limits cannot be negative");
+		gethandles()->setHandlePoolLimits(static_cast<size_t>(maxIdleHandles), std::chrono::milliseconds(idleTimeoutMs));
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<std::nullptr_t> NativeStoreApiWrapper::setFileHandleLabel(const StoreFileHandle handle,
+																		  const std::string& label){
+	ResultWithError<std::nullptr_t> res;
+	try{
+		gethandles()->label(handle, label);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<LiveFileHandleVector> NativeStoreApiWrapper::getLiveFileHandles(){
+	ResultWithError<LiveFileHandleVector> res;
+	try{
+		res.result = gethandles()->live();
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<std::string> NativeStoreApiWrapper::closeFile(StoreFileHandle handle){
+	ResultWithError<std::string> res;
+	try{
+		res.result = closeHandle(handle);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<std::nullptr_t> NativeStoreApiWrapper::enableFileDigest(StoreFileHandle handle){
+	ResultWithError<std::nullptr_t> res;
+	try{
+		// Chunks still queued were passed before this call and are hashed when written, let them land first.
+		getwriter()->flush(handle);
+		gethandles()->enableDigest(handle);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<FileDigest> NativeStoreApiWrapper::closeFileWithDigest(StoreFileHandle handle){
+	ResultWithError<FileDigest> res;
+	try{
+		try{
+			// Queued chunks are hashed as they are written, all of them have to land before the digest is taken.
+			getwriter()->flush(handle);
+		}catch(...){
+			// The content is incomplete, but the handle must not leak.
+			try{
+				closeHandle(handle);
+			}catch(...){}
+			throw;
+		}
+		auto digest = gethandles()->digest(handle);
+		if(!digest) throw std::logic_error("The digest was not enabled for the handle");
+		digest->fileId = closeHandle(handle);
+		res.result = *digest;
 		}catch(core::Exception& err){
 		res.error = {
 			.name = err.getName(),
@@ -462,6 +1433,7 @@ ResultWithError<std::nullptr_t> NativeStoreApiWrapper::deleteStore(const std::st
 	ResultWithError<std::nullptr_t> res;
 	try {
 		getapi()->deleteStore(storeId);
+		getdedup()->removeStore(storeId);
 		}catch(core::Exception& err){
 		res.error = {
 			.name = err.getName(),
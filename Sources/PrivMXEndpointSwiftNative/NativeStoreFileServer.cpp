@@ -0,0 +1,125 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "NativeStoreFileServer.hpp"
+#include "StoreFileServer.hpp"
+
+#include <stdexcept>
+
+namespace privmx {
+
+using namespace endpoint;
+
+ResultWithError<NativeStoreFileServer> NativeStoreFileServer::create(NativeStoreApiWrapper& storeApi,
+																	 int64_t port){
+	ResultWithError<NativeStoreFileServer> res;
+	try{
+		if(port < 0 || port > UINT16_MAX) throw std::invalid_argument("The port is out of range");
+		NativeStoreFileServer result;
+		result.server = std::make_shared<transfer::StoreFileServer>(storeApi.getapi(), storeApi.gethandles(), static_cast<uint16_t>(port));
+		res.result = result;
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<int64_t> NativeStoreFileServer::getPort(){
+	ResultWithError<int64_t> res;
+	try{
+		res.result = getserver()->port();
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<std::string> NativeStoreFileServer::getFileUrl(const std::string& fileId){
+	ResultWithError<std::string> res;
+	try{
+		res.result = getserver()->fileUrl(fileId);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<nullptr_t> NativeStoreFileServer::stop(){
+	ResultWithError<nullptr_t> res;
+	try{
+		getserver()->stop();
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+}
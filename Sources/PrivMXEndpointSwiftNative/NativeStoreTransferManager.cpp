@@ -0,0 +1,268 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "NativeStoreTransferManager.hpp"
+#include "TransferScheduler.hpp"
+
+#include <stdexcept>
+
+namespace privmx {
+
+using namespace endpoint;
+
+NativeStoreTransferManager::NativeStoreTransferManager(NativeStoreApiWrapper& storeApi, size_t concurrencyLimit) :
+	storeApi(storeApi),
+	scheduler(std::make_shared<transfer::TransferScheduler>(concurrencyLimit))
+{}
+
+ResultWithError<NativeStoreTransferManager> NativeStoreTransferManager::create(NativeStoreApiWrapper& storeApi,
+																			   int64_t concurrencyLimit){
+	ResultWithError<NativeStoreTransferManager> res;
+	try{
+		if(concurrencyLimit <= 0) throw std::invalid_argument("The concurrency limit must be positive");
+		storeApi.getapi();
+		res.result = NativeStoreTransferManager(storeApi, concurrencyLimit);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<int64_t> NativeStoreTransferManager::enqueueUpload(const std::string& storeId,
+																   const core::Buffer& publicMeta,
+																   const core::Buffer& privateMeta,
+																   const std::string& filePath,
+																   int64_t priority){
+	ResultWithError<int64_t> res;
+	try{
+		NativeStoreApiWrapper api = storeApi;
+		res.result = getscheduler()->enqueue([api, storeId, publicMeta, privateMeta, filePath](const transfer::TransferScheduler::Progress& progress) mutable {
+			return api.uploadFromPath(storeId, publicMeta, privateMeta, filePath, progress);
+		}, priority);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<int64_t> NativeStoreTransferManager::enqueueDownload(const std::string& fileId,
+																	 const std::string& filePath,
+																	 int64_t priority){
+	ResultWithError<int64_t> res;
+	try{
+		NativeStoreApiWrapper api = storeApi;
+		res.result = getscheduler()->enqueue([api, fileId, filePath](const transfer::TransferScheduler::Progress& progress) mutable {
+			api.downloadToPath(fileId, filePath, 0, progress);
+			return fileId;
+		}, priority);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<nullptr_t> NativeStoreTransferManager::setConcurrencyLimit(int64_t concurrencyLimit){
+	ResultWithError<nullptr_t> res;
+	try{
+		if(concurrencyLimit <= 0) throw std::invalid_argument("The concurrency limit must be positive");
+		getscheduler()->setConcurrencyLimit(concurrencyLimit);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<bool> NativeStoreTransferManager::cancelJob(int64_t jobId){
+	ResultWithError<bool> res;
+	try{
+		res.result = getscheduler()->cancel(jobId);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<TransferJobStatus> NativeStoreTransferManager::getJobStatus(int64_t jobId){
+	ResultWithError<TransferJobStatus> res;
+	try{
+		res.result = getscheduler()->status(jobId);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<TransferJobStatus> NativeStoreTransferManager::waitForJob(int64_t jobId){
+	ResultWithError<TransferJobStatus> res;
+	try{
+		res.result = getscheduler()->wait(jobId);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<TransferStats> NativeStoreTransferManager::getStats(){
+	ResultWithError<TransferStats> res;
+	try{
+		res.result = getscheduler()->stats();
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<nullptr_t> NativeStoreTransferManager::forgetFinishedJobs(){
+	ResultWithError<nullptr_t> res;
+	try{
+		getscheduler()->forgetFinished();
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+}
@@ -186,6 +186,37 @@ ResultWithError<std::string> NativeThreadApiWrapper::sendMessage(const std::stri
 	return res;
 }
 
+ResultWithError<std::string> NativeThreadApiWrapper::sendMessage(const std::string& threadId,
+																 const BufferView& publicMeta,
+																 const BufferView& privateMeta,
+																 const BufferView& data){
+	ResultWithError<std::string> res;
+	try {
+		res.result = getapi()->sendMessage(threadId,
+										   core::Buffer::from(publicMeta.data, publicMeta.size),
+										   core::Buffer::from(privateMeta.data, privateMeta.size),
+										   core::Buffer::from(data.data, data.size));
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
 ResultWithError<std::nullptr_t> NativeThreadApiWrapper::deleteThread(const std::string &threadId){
 	ResultWithError<std::nullptr_t> res;
 	try {
@@ -0,0 +1,171 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "NativeTransferConfig.hpp"
+#include "TransferMemoryBudget.hpp"
+#include "ChunkBufferPool.hpp"
+#include "ChunkSizeTuner.hpp"
+
+namespace privmx {
+
+using namespace endpoint;
+
+ResultWithError<nullptr_t> NativeTransferConfig::setMemoryBudget(int64_t bytes){
+	ResultWithError<nullptr_t> res;
+	try{
+		transfer::TransferMemoryBudget::instance().setLimit(bytes);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<TransferMemoryStats> NativeTransferConfig::getMemoryStats(){
+	ResultWithError<TransferMemoryStats> res;
+	try{
+		res.result = transfer::TransferMemoryBudget::instance().stats();
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<TransferBufferPoolStats> NativeTransferConfig::getBufferPoolStats(){
+	ResultWithError<TransferBufferPoolStats> res;
+	try{
+		res.result = transfer::ChunkBufferPool::instance().stats();
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<nullptr_t> NativeTransferConfig::trimBufferPool(){
+	ResultWithError<nullptr_t> res;
+	try{
+		transfer::ChunkBufferPool::instance().trim();
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<nullptr_t> NativeTransferConfig::setChunkSizeTuning(bool enabled, int64_t minChunkSize, int64_t maxChunkSize){
+	ResultWithError<nullptr_t> res;
+	try{
+		transfer::ChunkSizeTuner::configure(enabled, minChunkSize, maxChunkSize);
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+ResultWithError<TransferChunkStats> NativeTransferConfig::getChunkStats(){
+	ResultWithError<TransferChunkStats> res;
+	try{
+		res.result = transfer::ChunkSizeTuner::stats();
+		}catch(core::Exception& err){
+		res.error = {
+			.name = err.getName(),
+			.code = err.getCode(),
+			.description = err.getDescription(),
+			.message = err.what()
+		};
+	}catch (std::exception & err) {
+		res.error ={
+			.name = "std::Exception",
+			.message = err.what()
+		};
+	}catch (...) {
+		res.error ={
+			.name = "Unknown Exception",
+			.message = "Failed to work"
+		};
+	}
+	return res;
+}
+
+}
@@ -0,0 +1,161 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "OpenHandlePool.hpp"
+
+namespace privmx {
+namespace transfer {
+
+OpenHandlePool::OpenHandlePool(const HandleOps& ops) : ops(ops) {}
+
+OpenHandlePool::~OpenHandlePool(){
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wake.notify_all();
+	if(reaper.joinable()) reaper.join();
+	std::vector<int64_t> handles;
+	for(const auto& entry : idle){
+		handles.push_back(entry.lease.handle);
+	}
+	closeAll(handles);
+}
+
+void OpenHandlePool::setLimits(size_t capacity, std::chrono::milliseconds idleTimeout){
+	std::vector<int64_t> evicted;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		this->capacity = capacity;
+		this->idleTimeout = idleTimeout;
+		while(idle.size() > capacity){
+			evicted.push_back(idle.back().lease.handle);
+			idle.pop_back();
+		}
+	}
+	wake.notify_all();
+	closeAll(evicted);
+}
+
+PooledHandle OpenHandlePool::acquire(const std::string& fileId){
+	std::unique_lock<std::mutex> lock(mutex);
+	auto& file = versions[fileId];
+	++file.lent;
+	for(auto it = idle.begin(); it != idle.end(); ++it){
+		if(it->lease.fileId == fileId){
+			// Idle handles never outlive a change of their file, only the counter may have been reset since.
+			PooledHandle lease = it->lease;
+			lease.version = file.version;
+			idle.erase(it);
+			return lease;
+		}
+	}
+	PooledHandle lease{.fileId = fileId, .version = file.version};
+	lock.unlock();
+	try{
+		lease.handle = ops.open(fileId);
+	}catch(...){
+		returned(fileId);
+		throw;
+	}
+	return lease;
+}
+
+void OpenHandlePool::giveBack(const PooledHandle& lease){
+	std::vector<int64_t> evicted;
+	bool parked = false;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto& file = versions[lease.fileId];
+		if(lease.version != file.version || capacity == 0){
+			evicted.push_back(lease.handle);
+		}else{
+			PooledHandle idleLease = lease;
+			idleLease.reused = true;
+			idle.push_front(IdleHandle{.lease = idleLease, .parkedAt = std::chrono::steady_clock::now()});
+			parked = true;
+			while(idle.size() > capacity){
+				evicted.push_back(idle.back().lease.handle);
+				idle.pop_back();
+			}
+			if(!reaper.joinable()) reaper = std::thread(&OpenHandlePool::reap, this);
+		}
+		if(--file.lent == 0) versions.erase(lease.fileId);
+	}
+	// The reaper sleeps without a deadline once the pool is empty.
+	if(parked) wake.notify_all();
+	closeAll(evicted);
+}
+
+void OpenHandlePool::discard(const PooledHandle& lease){
+	returned(lease.fileId);
+	closeAll({lease.handle});
+}
+
+void OpenHandlePool::invalidate(const std::string& fileId){
+	std::vector<int64_t> stale;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto file = versions.find(fileId);
+		if(file != versions.end()) ++file->second.version;
+		for(auto it = idle.begin(); it != idle.end();){
+			if(it->lease.fileId == fileId){
+				stale.push_back(it->lease.handle);
+				it = idle.erase(it);
+			}else{
+				++it;
+			}
+		}
+	}
+	closeAll(stale);
+}
+
+void OpenHandlePool::returned(const std::string& fileId){
+	std::lock_guard<std::mutex> lock(mutex);
+	auto file = versions.find(fileId);
+	if(file != versions.end() && --file->second.lent == 0) versions.erase(file);
+}
+
+void OpenHandlePool::reap(){
+	std::unique_lock<std::mutex> lock(mutex);
+	while(!stopping){
+		if(idle.empty() || idleTimeout.count() <= 0){
+			wake.wait(lock);
+			continue;
+		}
+		auto now = std::chrono::steady_clock::now();
+		std::vector<int64_t> expired;
+		// The least recently parked handles are at the back.
+		while(!idle.empty() && idle.back().parkedAt + idleTimeout <= now){
+			expired.push_back(idle.back().lease.handle);
+			idle.pop_back();
+		}
+		if(expired.empty()){
+			wake.wait_until(lock, idle.back().parkedAt + idleTimeout);
+			continue;
+		}
+		lock.unlock();
+		closeAll(expired);
+		lock.lock();
+	}
+}
+
+void OpenHandlePool::closeAll(const std::vector<int64_t>& handles){
+	// Handles are closed outside of the lock, a failure only means the handle is gone already.
+	for(int64_t handle : handles){
+		try{
+			ops.close(handle);
+		}catch(...){}
+	}
+}
+
+}
+}
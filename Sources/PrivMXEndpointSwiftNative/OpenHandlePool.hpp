@@ -0,0 +1,115 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef _PRIVMX_ENDPOINT_SWIFT_NATIVE_OpenHandlePool_hpp
+#define _PRIVMX_ENDPOINT_SWIFT_NATIVE_OpenHandlePool_hpp
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace privmx {
+namespace transfer {
+
+/// Number of idle read handles kept open per Api instance, pooling is opt-in as pooled handles rely on events to see changes.
+constexpr size_t DEFAULT_IDLE_HANDLES = 0;
+/// Time after which an unused idle handle is closed.
+constexpr std::chrono::milliseconds DEFAULT_IDLE_TIMEOUT{30000};
+
+/**
+ * Opening and closing primitives of read handles.
+ */
+struct HandleOps{
+	std::function<int64_t(const std::string& fileId)> open;
+	std::function<void(int64_t handle)> close;
+};
+
+/**
+ * A read handle lent out by `OpenHandlePool`.
+ */
+struct PooledHandle{
+	std::string fileId;
+	int64_t handle = 0;
+	uint64_t version = 0; ///< Local version of the file content when the handle was lent out
+	bool reused = false; ///< Whether the handle was read before, its cursor position is then unspecified
+};
+
+/**
+ * Keeps read handles open between uses, so reading the same file again skips the cost of opening it.
+ *
+ * Idle handles are keyed by file ID and a local version of the file, bumped by `invalidate()`. A handle lent out before
+ * the file changed is closed instead of being parked when it comes back. At most `capacity` idle handles are kept,
+ * the least recently used ones are closed first, and handles idle for longer than the timeout are closed by a background thread.
+ */
+class OpenHandlePool{
+public:
+	explicit OpenHandlePool(const HandleOps& ops);
+
+	/// Closes the idle handles.
+	~OpenHandlePool();
+	OpenHandlePool(const OpenHandlePool&) = delete;
+	OpenHandlePool& operator=(const OpenHandlePool&) = delete;
+
+	/**
+	 * Sets how many idle handles are kept and for how long.
+	 *
+	 * A `capacity` of `0` disables pooling, an `idleTimeout` of `0` keeps idle handles until they are evicted or invalidated.
+	 */
+	void setLimits(size_t capacity, std::chrono::milliseconds idleTimeout);
+
+	/// Returns an idle handle of the file, or a freshly opened one.
+	PooledHandle acquire(const std::string& fileId);
+
+	/// Parks a handle obtained from `acquire()` for reuse, or closes it if the file has changed in the meantime.
+	void giveBack(const PooledHandle& lease);
+
+	/// Closes a handle obtained from `acquire()` that should not be reused, e.g. after a failed read.
+	void discard(const PooledHandle& lease);
+
+	/// Closes the idle handles of a file whose content has changed and keeps the lent out ones from being parked.
+	void invalidate(const std::string& fileId);
+
+private:
+	struct IdleHandle{
+		PooledHandle lease;
+		std::chrono::steady_clock::time_point parkedAt;
+	};
+	struct FileVersion{
+		uint64_t version = 0;
+		int lent = 0; ///< Handles lent out, the entry is dropped when it reaches `0`
+	};
+
+	void returned(const std::string& fileId);
+	void reap();
+	void closeAll(const std::vector<int64_t>& handles);
+
+	HandleOps ops;
+	std::mutex mutex;
+	std::condition_variable wake;
+	size_t capacity = DEFAULT_IDLE_HANDLES;
+	std::chrono::milliseconds idleTimeout = DEFAULT_IDLE_TIMEOUT;
+	bool stopping = false;
+	std::thread reaper; ///< Started with the first parked handle
+	std::list<IdleHandle> idle; ///< Most recently parked first
+	std::unordered_map<std::string, FileVersion> versions;
+};
+
+}
+}
+
+#endif /* _PRIVMX_ENDPOINT_SWIFT_NATIVE_OpenHandlePool_hpp */
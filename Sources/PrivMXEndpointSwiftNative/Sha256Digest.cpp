@@ -0,0 +1,58 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "Sha256Digest.hpp"
+
+#include <memory>
+#include <openssl/evp.h>
+#include <stdexcept>
+
+namespace privmx {
+namespace transfer {
+
+Sha256Digest::Sha256Digest() : context(EVP_MD_CTX_new()){
+	if(!context || EVP_DigestInit_ex(context, EVP_sha256(), nullptr) != 1){
+		EVP_MD_CTX_free(context);
+		throw std::runtime_error("Failed to initialise SHA-256");
+	}
+}
+
+Sha256Digest::~Sha256Digest(){
+	EVP_MD_CTX_free(context);
+}
+
+void Sha256Digest::update(const char* data, size_t size){
+	if(EVP_DigestUpdate(context, data, size) != 1){
+		throw std::runtime_error("Failed to update SHA-256");
+	}
+	hashed += size;
+}
+
+std::string Sha256Digest::hex() const {
+	// Finalising a copy keeps the running state usable for further updates.
+	std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)> copy(EVP_MD_CTX_new(), &EVP_MD_CTX_free);
+	unsigned char digest[EVP_MAX_MD_SIZE];
+	unsigned int length = 0;
+	if(!copy || EVP_MD_CTX_copy_ex(copy.get(), context) != 1 || EVP_DigestFinal_ex(copy.get(), digest, &length) != 1){
+		throw std::runtime_error("Failed to finalise SHA-256");
+	}
+	static const char* digits = "0123456789abcdef";
+	std::string out;
+	out.reserve(length * 2);
+	for(unsigned int i = 0; i < length; i++){
+		out.push_back(digits[digest[i] >> 4]);
+		out.push_back(digits[digest[i] & 0x0f]);
+	}
+	return out;
+}
+
+}
+}
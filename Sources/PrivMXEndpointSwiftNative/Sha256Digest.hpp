@@ -0,0 +1,50 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef _PRIVMX_ENDPOINT_SWIFT_NATIVE_Sha256Digest_hpp
+#define _PRIVMX_ENDPOINT_SWIFT_NATIVE_Sha256Digest_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+typedef struct evp_md_ctx_st EVP_MD_CTX;
+
+namespace privmx {
+namespace transfer {
+
+/**
+ * Incremental SHA-256 of a stream of chunks.
+ */
+class Sha256Digest{
+public:
+	Sha256Digest();
+	~Sha256Digest();
+	Sha256Digest(const Sha256Digest&) = delete;
+	Sha256Digest& operator=(const Sha256Digest&) = delete;
+
+	void update(const char* data, size_t size);
+
+	/// Returns the lowercase hex digest of the data passed so far, without ending the stream.
+	std::string hex() const;
+
+	/// Number of bytes passed so far.
+	int64_t size() const { return hashed; }
+
+private:
+	EVP_MD_CTX* context;
+	int64_t hashed = 0;
+};
+
+}
+}
+
+#endif /* _PRIVMX_ENDPOINT_SWIFT_NATIVE_Sha256Digest_hpp */
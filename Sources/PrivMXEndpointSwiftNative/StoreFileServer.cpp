@@ -0,0 +1,243 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "StoreFileServer.hpp"
+#include "FileHandleRegistry.hpp"
+#include "FileTransferUtils.hpp"
+
+#include <algorithm>
+#include <openssl/rand.h>
+#include <stdexcept>
+#include <vector>
+
+#include "Poco/Net/HTTPRequestHandler.h"
+#include "Poco/Net/HTTPRequestHandlerFactory.h"
+#include "Poco/Net/HTTPServer.h"
+#include "Poco/Net/HTTPServerParams.h"
+#include "Poco/Net/HTTPServerRequest.h"
+#include "Poco/Net/HTTPServerResponse.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/Net/SocketAddress.h"
+#include "Poco/URI.h"
+#include "privmx/endpoint/core/Exception.hpp"
+
+namespace privmx {
+namespace transfer {
+
+using namespace endpoint;
+using Poco::Net::HTTPResponse;
+
+namespace {
+
+/// Number of requests served at the same time, players usually keep one or two connections per file.
+constexpr int MAX_SERVER_THREADS = 8;
+
+bool parseOffset(const std::string& text, int64_t& value){
+	if(text.empty() || text.size() > 18) return false;
+	value = 0;
+	for(char c : text){
+		if(c < '0' || c > '9') return false;
+		value = value * 10 + (c - '0');
+	}
+	return true;
+}
+
+std::string randomToken(){
+	unsigned char bytes[16];
+	if(RAND_bytes(bytes, sizeof(bytes)) != 1) throw std::runtime_error("Failed to generate the server token");
+	static const char* digits = "0123456789abcdef";
+	std::string token;
+	for(unsigned char byte : bytes){
+		token.push_back(digits[byte >> 4]);
+		token.push_back(digits[byte & 0x0f]);
+	}
+	return token;
+}
+
+class FileRangeHandler : public Poco::Net::HTTPRequestHandler{
+public:
+	FileRangeHandler(std::shared_ptr<store::StoreApi> api, std::shared_ptr<FileHandleRegistry> handles, const std::string& token) :
+		api(api), handles(handles), token(token) {}
+
+	void handleRequest(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response) override{
+		response.setKeepAlive(true);
+		if(request.getMethod() != Poco::Net::HTTPRequest::HTTP_GET && request.getMethod() != Poco::Net::HTTPRequest::HTTP_HEAD){
+			return sendEmpty(response, HTTPResponse::HTTP_METHOD_NOT_ALLOWED);
+		}
+		Poco::URI uri(request.getURI());
+		std::vector<std::string> segments;
+		uri.getPathSegments(segments);
+		if(segments.size() != 2 || segments[0] != "files"){
+			return sendEmpty(response, HTTPResponse::HTTP_NOT_FOUND);
+		}
+		std::string requestToken, contentType = "application/octet-stream";
+		for(const auto& [name, value] : uri.getQueryParameters()){
+			if(name == "token") requestToken = value;
+			if(name == "type") contentType = value;
+		}
+		if(requestToken != token){
+			return sendEmpty(response, HTTPResponse::HTTP_FORBIDDEN);
+		}
+		const std::string& fileId = segments[1];
+		int64_t size;
+		try{
+			size = api->getFile(fileId).size;
+		}catch(const core::Exception&){
+			return sendEmpty(response, HTTPResponse::HTTP_NOT_FOUND);
+		}
+		// Opened before the headers are sent, as the size of a compressed File is only known from its header,
+		// and so a failure can still be reported with a proper status.
+		OpenedFile file(*this);
+		try{
+			file.handle = handles->open(fileId);
+			if(auto layout = handles->detectLayout(fileId, file.handle)) size = layout->originalSize;
+		}catch(const std::exception&){
+			return sendEmpty(response, HTTPResponse::HTTP_INTERNAL_SERVER_ERROR);
+		}
+
+		ByteRange range = parseByteRange(request.has("Range") ? request.get("Range") : std::string(), size);
+		response.set("Accept-Ranges", "bytes");
+		if(range.kind == ByteRange::Unsatisfiable){
+			response.set("Content-Range", "bytes */" + std::to_string(size));
+			return sendEmpty(response, HTTPResponse::HTTP_REQUESTED_RANGE_NOT_SATISFIABLE);
+		}
+		if(range.kind == ByteRange::Full){
+			range.first = 0;
+			range.last = size - 1;
+			response.setStatusAndReason(HTTPResponse::HTTP_OK);
+		}else{
+			response.set("Content-Range", "bytes " + std::to_string(range.first) + "-" + std::to_string(range.last) + "/" + std::to_string(size));
+			response.setStatusAndReason(HTTPResponse::HTTP_PARTIAL_CONTENT);
+		}
+		int64_t remaining = range.last - range.first + 1;
+		response.setContentType(contentType);
+		response.setContentLength64(remaining);
+		if(request.getMethod() == Poco::Net::HTTPRequest::HTTP_HEAD || remaining == 0){
+			response.send();
+			return;
+		}
+
+		try{
+			if(range.first > 0) handles->seek(file.handle, range.first);
+		}catch(const std::exception&){
+			return sendEmpty(response, HTTPResponse::HTTP_INTERNAL_SERVER_ERROR);
+		}
+		// A failure past this point propagates and drops the connection, the headers are gone already.
+		std::ostream& out = response.send();
+		while(remaining > 0 && out){
+			// The registry reserves the transfer memory budget for the chunk.
+			core::Buffer chunk = handles->read(file.handle, std::min(remaining, DEFAULT_CHUNK_SIZE));
+			if(chunk.size() == 0) break;
+			out.write(chunk.data(), chunk.size());
+			remaining -= chunk.size();
+		}
+	}
+
+private:
+	static void sendEmpty(Poco::Net::HTTPServerResponse& response, HTTPResponse::HTTPStatus status){
+		response.setStatusAndReason(status);
+		response.setContentLength64(0);
+		response.send();
+	}
+
+	/// Handle opened through the registry, given back to it or closed when the response ends.
+	struct OpenedFile{
+		explicit OpenedFile(FileRangeHandler& owner) : owner(owner) {}
+		~OpenedFile(){
+			if(handle < 0) return;
+			try{
+				if(owner.handles->recycle(handle)) return;
+				owner.handles->release(handle);
+				owner.api->closeFile(handle);
+			}catch(...){}
+		}
+
+		FileRangeHandler& owner;
+		int64_t handle = -1;
+	};
+
+	std::shared_ptr<store::StoreApi> api;
+	std::shared_ptr<FileHandleRegistry> handles;
+	const std::string token;
+};
+
+class FileRangeHandlerFactory : public Poco::Net::HTTPRequestHandlerFactory{
+public:
+	FileRangeHandlerFactory(std::shared_ptr<store::StoreApi> api, std::shared_ptr<FileHandleRegistry> handles, const std::string& token) :
+		api(api), handles(handles), token(token) {}
+
+	Poco::Net::HTTPRequestHandler* createRequestHandler(const Poco::Net::HTTPServerRequest&) override{
+		return new FileRangeHandler(api, handles, token);
+	}
+
+private:
+	std::shared_ptr<store::StoreApi> api;
+	std::shared_ptr<FileHandleRegistry> handles;
+	std::string token;
+};
+
+}
+
+ByteRange parseByteRange(const std::string& header, int64_t size){
+	const std::string prefix = "bytes=";
+	if(header.compare(0, prefix.size(), prefix) != 0) return ByteRange();
+	std::string spec = header.substr(prefix.size());
+	spec.erase(std::remove(spec.begin(), spec.end(), ' '), spec.end());
+	size_t dash = spec.find('-');
+	if(dash == std::string::npos || spec.find(',') != std::string::npos) return ByteRange();
+	std::string firstText = spec.substr(0, dash), lastText = spec.substr(dash + 1);
+	int64_t first, last;
+	if(firstText.empty()){
+		// Suffix form: the last N bytes.
+		if(!parseOffset(lastText, last)) return ByteRange();
+		if(last == 0 || size == 0) return ByteRange{.kind = ByteRange::Unsatisfiable};
+		return ByteRange{.kind = ByteRange::Partial, .first = std::max<int64_t>(size - last, 0), .last = size - 1};
+	}
+	if(!parseOffset(firstText, first)) return ByteRange();
+	if(lastText.empty()){
+		last = size - 1;
+	}else if(!parseOffset(lastText, last) || last < first){
+		return ByteRange();
+	}
+	if(first >= size) return ByteRange{.kind = ByteRange::Unsatisfiable};
+	return ByteRange{.kind = ByteRange::Partial, .first = first, .last = std::min(last, size - 1)};
+}
+
+StoreFileServer::StoreFileServer(std::shared_ptr<store::StoreApi> api, std::shared_ptr<FileHandleRegistry> handles, uint16_t port) :
+	token(randomToken()){
+	Poco::Net::ServerSocket socket(Poco::Net::SocketAddress("127.0.0.1", port));
+	boundPort = socket.address().port();
+	Poco::Net::HTTPServerParams::Ptr params = new Poco::Net::HTTPServerParams();
+	params->setKeepAlive(true);
+	params->setMaxThreads(MAX_SERVER_THREADS);
+	server = std::make_unique<Poco::Net::HTTPServer>(new FileRangeHandlerFactory(api, handles, token), socket, params);
+	server->start();
+}
+
+StoreFileServer::~StoreFileServer(){
+	stop();
+}
+
+std::string StoreFileServer::fileUrl(const std::string& fileId){
+	std::lock_guard<std::mutex> lock(mutex);
+	if(!server) throw std::runtime_error("The file server has been stopped");
+	return "http://127.0.0.1:" + std::to_string(boundPort) + "/files/" + fileId + "?token=" + token;
+}
+
+void StoreFileServer::stop(){
+	std::lock_guard<std::mutex> lock(mutex);
+	if(!server) return;
+	server->stopAll(true);
+	server.reset();
+}
+
+}
+}
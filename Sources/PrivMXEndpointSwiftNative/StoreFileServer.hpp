@@ -0,0 +1,88 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef _PRIVMX_ENDPOINT_SWIFT_NATIVE_StoreFileServer_hpp
+#define _PRIVMX_ENDPOINT_SWIFT_NATIVE_StoreFileServer_hpp
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "privmx/endpoint/store/StoreApi.hpp"
+
+namespace Poco {
+namespace Net {
+class HTTPServer;
+}
+}
+
+namespace privmx {
+namespace transfer {
+
+class FileHandleRegistry;
+
+/**
+ * Outcome of matching a `Range` request header against a file.
+ */
+struct ByteRange{
+	enum Kind{
+		Full, ///< No usable range was requested, the whole file is sent
+		Partial, ///< The bytes `first`..`last` (inclusive) are sent
+		Unsatisfiable ///< The requested range lies outside of the file
+	};
+	Kind kind = Full;
+	int64_t first = 0;
+	int64_t last = -1;
+};
+
+/**
+ * Matches a `Range` header against a file of `size` bytes.
+ *
+ * Supports a single `bytes=` range in any of its three forms. Headers that cannot be parsed, use other units or request
+ * several ranges are ignored, as allowed by RFC 9110.
+ */
+ByteRange parseByteRange(const std::string& header, int64_t size);
+
+/**
+ * HTTP server on the loopback interface that streams decrypted Store files.
+ *
+ * Serves `GET` and `HEAD` requests for `/files/{fileId}?token={token}`, honouring `Range` headers and keeping connections alive.
+ * The random token keeps other local processes from reading the files. An optional `type` query parameter sets the `Content-Type`.
+ * Files are read through the handle registry of the Store Api, so Files uploaded compressed are served decompressed when
+ * transparent decompression is enabled.
+ */
+class StoreFileServer{
+public:
+	StoreFileServer(std::shared_ptr<endpoint::store::StoreApi> api, std::shared_ptr<FileHandleRegistry> handles, uint16_t port);
+	~StoreFileServer();
+	StoreFileServer(const StoreFileServer&) = delete;
+	StoreFileServer& operator=(const StoreFileServer&) = delete;
+
+	uint16_t port() const { return boundPort; }
+
+	/// Returns the URL under which the file is served, throws once the server has been stopped.
+	std::string fileUrl(const std::string& fileId);
+
+	/// Stops accepting connections and aborts the ongoing responses.
+	void stop();
+
+private:
+	std::mutex mutex;
+	std::string token;
+	uint16_t boundPort = 0;
+	std::unique_ptr<Poco::Net::HTTPServer> server;
+};
+
+}
+}
+
+#endif /* _PRIVMX_ENDPOINT_SWIFT_NATIVE_StoreFileServer_hpp */
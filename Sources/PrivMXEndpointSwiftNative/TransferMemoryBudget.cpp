@@ -0,0 +1,140 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "TransferMemoryBudget.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace privmx {
+namespace transfer {
+
+MemoryReservation::~MemoryReservation(){
+	release();
+}
+
+MemoryReservation::MemoryReservation(MemoryReservation&& other) noexcept : bytes(other.bytes){
+	other.bytes = 0;
+}
+
+MemoryReservation& MemoryReservation::operator=(MemoryReservation&& other) noexcept{
+	if(this != &other){
+		release();
+		bytes = other.bytes;
+		other.bytes = 0;
+	}
+	return *this;
+}
+
+void MemoryReservation::release(){
+	if(bytes > 0) TransferMemoryBudget::instance().release(bytes);
+	bytes = 0;
+}
+
+TransferMemoryBudget& TransferMemoryBudget::instance(){
+	static TransferMemoryBudget budget;
+	return budget;
+}
+
+void TransferMemoryBudget::setLimit(int64_t bytes){
+	if(bytes < 0) throw std::invalid_argument("The memory budget cannot be negative");
+	std::lock_guard<std::mutex> lock(mutex);
+	limit = bytes;
+	released.notify_all();
+}
+
+MemoryReservation TransferMemoryBudget::reserve(int64_t bytes){
+	std::unique_lock<std::mutex> lock(mutex);
+	if(!fits(bytes)){
+		waits++;
+		waiting++;
+		int64_t missing = reserved + bytes - limit;
+		lock.unlock();
+		reclaim(missing);
+		lock.lock();
+		released.wait(lock, [&]{ return fits(bytes); });
+		waiting--;
+	}
+	return grant(bytes);
+}
+
+std::optional<MemoryReservation> TransferMemoryBudget::tryReserve(int64_t bytes, std::chrono::milliseconds timeout){
+	std::unique_lock<std::mutex> lock(mutex);
+	if(!fits(bytes)){
+		waits++;
+		waiting++;
+		int64_t missing = reserved + bytes - limit;
+		lock.unlock();
+		reclaim(missing);
+		lock.lock();
+		bool granted = released.wait_for(lock, timeout, [&]{ return fits(bytes); });
+		waiting--;
+		if(!granted) return std::nullopt;
+	}
+	return grant(bytes);
+}
+
+std::optional<MemoryReservation> TransferMemoryBudget::reserveReclaimable(int64_t bytes){
+	std::lock_guard<std::mutex> lock(mutex);
+	// Memory a transfer is waiting for is never taken by a cache.
+	if(waiting > 0 || !fits(bytes)) return std::nullopt;
+	return grant(bytes);
+}
+
+int64_t TransferMemoryBudget::addReclaimer(Reclaimer reclaimer){
+	std::lock_guard<std::mutex> lock(reclaimMutex);
+	reclaimers[++lastReclaimerId] = std::move(reclaimer);
+	return lastReclaimerId;
+}
+
+void TransferMemoryBudget::removeReclaimer(int64_t id){
+	std::lock_guard<std::mutex> lock(reclaimMutex);
+	reclaimers.erase(id);
+}
+
+void TransferMemoryBudget::reclaim(int64_t bytes){
+	// Reclaimers free memory through `release()`, which takes `mutex`, so they run under their own lock only.
+	std::lock_guard<std::mutex> lock(reclaimMutex);
+	for(auto& [id, reclaimer] : reclaimers){
+		if(bytes <= 0) break;
+		bytes -= reclaimer(bytes);
+	}
+}
+
+TransferMemoryStats TransferMemoryBudget::stats(){
+	std::lock_guard<std::mutex> lock(mutex);
+	return TransferMemoryStats{
+		.budget = limit,
+		.reservedBytes = reserved,
+		.peakReservedBytes = peakReserved,
+		.waitCount = waits
+	};
+}
+
+bool TransferMemoryBudget::fits(int64_t bytes) const {
+	return limit == 0 || reserved == 0 || reserved + bytes <= limit;
+}
+
+MemoryReservation TransferMemoryBudget::grant(int64_t bytes){
+	bytes = std::max<int64_t>(bytes, 0);
+	reserved += bytes;
+	peakReserved = std::max(peakReserved, reserved);
+	return MemoryReservation(bytes);
+}
+
+void TransferMemoryBudget::release(int64_t bytes){
+	std::lock_guard<std::mutex> lock(mutex);
+	reserved -= bytes;
+	released.notify_all();
+}
+
+}
+}
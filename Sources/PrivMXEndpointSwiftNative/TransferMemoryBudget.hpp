@@ -0,0 +1,115 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef _PRIVMX_ENDPOINT_SWIFT_NATIVE_TransferMemoryBudget_hpp
+#define _PRIVMX_ENDPOINT_SWIFT_NATIVE_TransferMemoryBudget_hpp
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+
+#include "NativeTransferConfig.hpp"
+
+namespace privmx {
+namespace transfer {
+
+class TransferMemoryBudget;
+
+/**
+ * Part of the transfer memory budget held by a single chunk buffer, returned on destruction.
+ */
+class MemoryReservation{
+public:
+	MemoryReservation() = default;
+	~MemoryReservation();
+	MemoryReservation(MemoryReservation&& other) noexcept;
+	MemoryReservation& operator=(MemoryReservation&& other) noexcept;
+	MemoryReservation(const MemoryReservation&) = delete;
+	MemoryReservation& operator=(const MemoryReservation&) = delete;
+
+	int64_t size() const { return bytes; }
+
+	/// Returns the reserved bytes to the budget early.
+	void release();
+
+private:
+	friend class TransferMemoryBudget;
+	explicit MemoryReservation(int64_t bytes) : bytes(bytes) {}
+
+	int64_t bytes = 0;
+};
+
+/**
+ * Process-wide limit of the memory held by in-flight transfer chunks.
+ *
+ * Every Store and Inbox transfer reserves the size of a chunk before allocating it.
+ * A reservation that does not fit waits until other transfers return memory, so the limit slows transfers down instead of failing them.
+ * A single reservation larger than the whole budget is granted once nothing else is reserved.
+ * Caches holding budget memory register a reclaimer, asked to give memory back before a reservation waits.
+ */
+class TransferMemoryBudget{
+public:
+	static TransferMemoryBudget& instance();
+
+	/// Sets the budget in bytes, `0` removes the limit. Waiting reservations are re-evaluated immediately.
+	void setLimit(int64_t bytes);
+
+	/// Blocks until `bytes` fit in the budget.
+	MemoryReservation reserve(int64_t bytes);
+
+	/// Waits at most `timeout` for `bytes` to fit in the budget.
+	std::optional<MemoryReservation> tryReserve(int64_t bytes, std::chrono::milliseconds timeout);
+
+	/// Reserves `bytes` for memory that can be given back on demand, only if they fit and no transfer is waiting for memory.
+	std::optional<MemoryReservation> reserveReclaimable(int64_t bytes);
+
+	/// Frees up to the requested amount of reclaimable memory and returns how much was freed. Must not call back into the budget's waits.
+	using Reclaimer = std::function<int64_t(int64_t bytes)>;
+
+	/// Registers a reclaimer and returns its ID for `removeReclaimer()`.
+	int64_t addReclaimer(Reclaimer reclaimer);
+
+	/// Unregisters a reclaimer, waiting for a running call of it to return.
+	void removeReclaimer(int64_t id);
+
+	TransferMemoryStats stats();
+
+private:
+	friend class MemoryReservation;
+	TransferMemoryBudget() = default;
+
+	bool fits(int64_t bytes) const;
+	MemoryReservation grant(int64_t bytes);
+	void release(int64_t bytes);
+	/// Called without `mutex` held when a reservation of `bytes` does not fit.
+	void reclaim(int64_t bytes);
+
+	std::mutex mutex;
+	std::condition_variable released;
+	int64_t limit = 0;
+	int64_t reserved = 0;
+	int64_t peakReserved = 0;
+	int64_t waits = 0;
+	int64_t waiting = 0; ///< Reservations currently waiting for memory
+
+	std::mutex reclaimMutex;
+	int64_t lastReclaimerId = 0;
+	std::map<int64_t, Reclaimer> reclaimers;
+};
+
+}
+}
+
+#endif /* _PRIVMX_ENDPOINT_SWIFT_NATIVE_TransferMemoryBudget_hpp */
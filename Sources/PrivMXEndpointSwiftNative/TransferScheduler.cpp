@@ -0,0 +1,201 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "TransferScheduler.hpp"
+
+#include <stdexcept>
+
+namespace privmx {
+namespace transfer {
+
+using namespace endpoint;
+
+TransferScheduler::TransferScheduler(size_t concurrencyLimit){
+	setConcurrencyLimit(concurrencyLimit);
+}
+
+TransferScheduler::~TransferScheduler(){
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+		while(!queue.empty()){
+			auto& status = statuses[queue.top().jobId];
+			if(status.state == TransferJobState::Queued){
+				status.state = TransferJobState::Cancelled;
+				cancelledJobs++;
+			}
+			queue.pop();
+		}
+		jobs.clear();
+	}
+	changed.notify_all();
+	for(auto& worker : workers){
+		worker.join();
+	}
+}
+
+int64_t TransferScheduler::enqueue(Job job, int64_t priority){
+	std::lock_guard<std::mutex> lock(mutex);
+	int64_t jobId = ++lastJobId;
+	jobs[jobId] = std::move(job);
+	statuses[jobId] = TransferJobStatus{.jobId = jobId};
+	queue.push(QueuedJob{.priority = priority, .jobId = jobId});
+	queuedJobs++;
+	changed.notify_all();
+	return jobId;
+}
+
+void TransferScheduler::setConcurrencyLimit(size_t limit){
+	if(limit == 0) throw std::invalid_argument("The concurrency limit must be positive");
+	std::lock_guard<std::mutex> lock(mutex);
+	concurrencyLimit = limit;
+	// Workers are only ever added, the ones above a lowered limit stay idle.
+	while(workers.size() < limit){
+		workers.emplace_back(&TransferScheduler::run, this);
+	}
+	changed.notify_all();
+}
+
+bool TransferScheduler::cancel(int64_t jobId){
+	std::lock_guard<std::mutex> lock(mutex);
+	auto& status = find(jobId);
+	if(status.state != TransferJobState::Queued) return false;
+	// The entry stays in the queue and is skipped once it reaches the top.
+	status.state = TransferJobState::Cancelled;
+	jobs.erase(jobId);
+	queuedJobs--;
+	cancelledJobs++;
+	changed.notify_all();
+	return true;
+}
+
+TransferJobStatus TransferScheduler::status(int64_t jobId){
+	std::lock_guard<std::mutex> lock(mutex);
+	return find(jobId);
+}
+
+TransferJobStatus TransferScheduler::wait(int64_t jobId){
+	std::unique_lock<std::mutex> lock(mutex);
+	find(jobId);
+	// Keeps `forgetFinished()` from dropping the status before this thread wakes up to read it.
+	waiters[jobId]++;
+	TransferJobStatus result;
+	changed.wait(lock, [&]{
+		const auto& status = statuses.at(jobId);
+		if(!isFinished(status.state)) return false;
+		result = status;
+		return true;
+	});
+	if(--waiters[jobId] == 0) waiters.erase(jobId);
+	return result;
+}
+
+TransferStats TransferScheduler::stats(){
+	std::lock_guard<std::mutex> lock(mutex);
+	double seconds = std::chrono::duration<double>(busyTime()).count();
+	return TransferStats{
+		.queuedJobs = queuedJobs,
+		.runningJobs = static_cast<int64_t>(running),
+		.completedJobs = completedJobs,
+		.failedJobs = failedJobs,
+		.cancelledJobs = cancelledJobs,
+		.bytesTransferred = bytesTransferred,
+		.bytesPerSecond = seconds > 0 ? bytesTransferred / seconds : 0,
+		.concurrencyLimit = static_cast<int64_t>(concurrencyLimit)
+	};
+}
+
+void TransferScheduler::forgetFinished(){
+	std::lock_guard<std::mutex> lock(mutex);
+	for(auto it = statuses.begin(); it != statuses.end();){
+		if(isFinished(it->second.state) && !waiters.count(it->first)){
+			it = statuses.erase(it);
+		}else{
+			++it;
+		}
+	}
+}
+
+void TransferScheduler::run(){
+	std::unique_lock<std::mutex> lock(mutex);
+	while(true){
+		changed.wait(lock, [this]{ return stopping || (!queue.empty() && running < concurrencyLimit); });
+		if(stopping) return;
+		int64_t jobId = queue.top().jobId;
+		queue.pop();
+		auto jobIt = jobs.find(jobId);
+		if(jobIt == jobs.end()) continue; // cancelled while queued
+		Job job = std::move(jobIt->second);
+		jobs.erase(jobIt);
+		statuses[jobId].state = TransferJobState::Running;
+		queuedJobs--;
+		if(running++ == 0) busySince = std::chrono::steady_clock::now();
+		lock.unlock();
+
+		Progress progress = [this, jobId](int64_t bytes){
+			std::lock_guard<std::mutex> lock(mutex);
+			bytesTransferred += bytes;
+			auto it = statuses.find(jobId);
+			if(it != statuses.end()) it->second.bytesTransferred += bytes;
+		};
+		std::string fileId;
+		std::optional<InternalError> error;
+		try{
+			fileId = job(progress);
+			}catch(core::Exception& err){
+			error = {
+				.name = err.getName(),
+				.code = err.getCode(),
+				.description = err.getDescription(),
+				.message = err.what()
+			};
+		}catch (std::exception & err) {
+			error ={
+				.name = "std::Exception",
+				.message = err.what()
+			};
+		}catch (...) {
+			error ={
+				.name = "Unknown Exception",
+				.message = "Failed to work"
+			};
+		}
+
+		lock.lock();
+		if(--running == 0) busyBefore += std::chrono::steady_clock::now() - busySince;
+		auto& status = statuses[jobId];
+		status.fileId = fileId;
+		status.error = error;
+		status.state = error ? TransferJobState::Failed : TransferJobState::Completed;
+		(error ? failedJobs : completedJobs)++;
+		changed.notify_all();
+	}
+}
+
+TransferJobStatus& TransferScheduler::find(int64_t jobId){
+	auto it = statuses.find(jobId);
+	if(it == statuses.end()) throw std::out_of_range("Unknown transfer job: " + std::to_string(jobId));
+	return it->second;
+}
+
+bool TransferScheduler::isFinished(TransferJobState state){
+	return state == TransferJobState::Completed
+		|| state == TransferJobState::Failed
+		|| state == TransferJobState::Cancelled;
+}
+
+std::chrono::steady_clock::duration TransferScheduler::busyTime(){
+	if(running == 0) return busyBefore;
+	return busyBefore + (std::chrono::steady_clock::now() - busySince);
+}
+
+}
+}
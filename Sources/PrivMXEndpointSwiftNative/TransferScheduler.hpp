@@ -0,0 +1,107 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef _PRIVMX_ENDPOINT_SWIFT_NATIVE_TransferScheduler_hpp
+#define _PRIVMX_ENDPOINT_SWIFT_NATIVE_TransferScheduler_hpp
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "NativeStoreTransferManager.hpp"
+
+namespace privmx {
+namespace transfer {
+
+/**
+ * Runs queued transfer jobs on a pool of worker threads.
+ *
+ * Jobs with a higher priority start first, jobs of equal priority start in the order they were queued.
+ * At most `concurrencyLimit` jobs run at the same time.
+ */
+class TransferScheduler{
+public:
+	/// Reports the amount of bytes moved since the previous call.
+	using Progress = std::function<void(int64_t bytes)>;
+	/// Performs a transfer and returns the ID of the transferred File.
+	using Job = std::function<std::string(const Progress& progress)>;
+
+	explicit TransferScheduler(size_t concurrencyLimit);
+
+	/// Cancels the queued jobs and waits for the running ones.
+	~TransferScheduler();
+	TransferScheduler(const TransferScheduler&) = delete;
+	TransferScheduler& operator=(const TransferScheduler&) = delete;
+
+	int64_t enqueue(Job job, int64_t priority);
+
+	/// Changes the number of jobs allowed to run at the same time. Running jobs are never interrupted.
+	void setConcurrencyLimit(size_t limit);
+
+	/// Cancels a job that has not started yet, returns `false` if it is already running or finished.
+	bool cancel(int64_t jobId);
+
+	TransferJobStatus status(int64_t jobId);
+
+	/// Blocks until the job is finished and returns its final status.
+	TransferJobStatus wait(int64_t jobId);
+
+	TransferStats stats();
+
+	/// Drops the statuses of finished jobs, except those still awaited by `wait()`.
+	void forgetFinished();
+
+private:
+	struct QueuedJob{
+		int64_t priority;
+		int64_t jobId;
+		bool operator<(const QueuedJob& other) const {
+			// std::priority_queue pops the greatest element first.
+			if(priority != other.priority) return priority < other.priority;
+			return jobId > other.jobId;
+		}
+	};
+
+	void run();
+	TransferJobStatus& find(int64_t jobId);
+	static bool isFinished(TransferJobState state);
+	std::chrono::steady_clock::duration busyTime();
+
+	std::mutex mutex;
+	std::condition_variable changed;
+	size_t concurrencyLimit;
+	size_t running = 0;
+	bool stopping = false;
+	int64_t lastJobId = 0;
+	std::priority_queue<QueuedJob> queue;
+	std::map<int64_t, Job> jobs;
+	std::map<int64_t, TransferJobStatus> statuses;
+	std::map<int64_t, int> waiters; ///< Number of threads in `wait()` per job
+	std::vector<std::thread> workers;
+
+	int64_t queuedJobs = 0;
+	int64_t completedJobs = 0;
+	int64_t failedJobs = 0;
+	int64_t cancelledJobs = 0;
+	int64_t bytesTransferred = 0;
+	std::chrono::steady_clock::duration busyBefore{0};
+	std::chrono::steady_clock::time_point busySince;
+};
+
+}
+}
+
+#endif /* _PRIVMX_ENDPOINT_SWIFT_NATIVE_TransferScheduler_hpp */
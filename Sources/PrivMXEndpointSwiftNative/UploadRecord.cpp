@@ -0,0 +1,77 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "UploadRecord.hpp"
+#include "FileTransferUtils.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <system_error>
+
+namespace privmx {
+namespace transfer {
+
+namespace {
+
+const char* const RECORD_HEADER = "privmx-upload-record 1";
+
+}
+
+std::optional<UploadRecord> loadUploadRecord(const std::string& path){
+	std::ifstream in(path);
+	if(!in) return std::nullopt;
+	std::string line;
+	if(!std::getline(in, line) || line != RECORD_HEADER) return std::nullopt;
+	std::map<std::string, std::string> fields;
+	while(std::getline(in, line)){
+		size_t separator = line.find('=');
+		if(separator == std::string::npos) return std::nullopt;
+		fields[line.substr(0, separator)] = line.substr(separator + 1);
+	}
+	try{
+		return UploadRecord{
+			.storeId = fields.at("storeId"),
+			.filePath = fields.at("filePath"),
+			.fileSize = std::stoll(fields.at("fileSize")),
+			.modificationTime = std::stoll(fields.at("modificationTime")),
+			.sha256 = fields.at("sha256"),
+			.fileId = fields.at("fileId")
+		};
+	}catch(const std::exception&){
+		return std::nullopt;
+	}
+}
+
+void saveUploadRecord(const std::string& path, const UploadRecord& record){
+	std::ostringstream out;
+	out << RECORD_HEADER << "\n"
+		<< "storeId=" << record.storeId << "\n"
+		<< "filePath=" << record.filePath << "\n"
+		<< "fileSize=" << record.fileSize << "\n"
+		<< "modificationTime=" << record.modificationTime << "\n"
+		<< "sha256=" << record.sha256 << "\n"
+		<< "fileId=" << record.fileId << "\n";
+	const std::string content = out.str();
+	const std::string tempPath = path + ".tmp";
+	{
+		OutputFile file(tempPath);
+		file.write(content.data(), content.size());
+	}
+	if(std::rename(tempPath.c_str(), path.c_str()) != 0){
+		throw std::system_error(errno, std::generic_category(), "Failed to store the upload record at " + path);
+	}
+}
+
+}
+}
@@ -0,0 +1,32 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef _PRIVMX_ENDPOINT_SWIFT_NATIVE_UploadRecord_hpp
+#define _PRIVMX_ENDPOINT_SWIFT_NATIVE_UploadRecord_hpp
+
+#include <optional>
+#include <string>
+
+#include "NativeStoreApiWrapper.hpp"
+
+namespace privmx {
+namespace transfer {
+
+/// Returns the record stored at `path`, or `std::nullopt` if there is none or it cannot be parsed.
+std::optional<UploadRecord> loadUploadRecord(const std::string& path);
+
+/// Atomically replaces the record stored at `path`.
+void saveUploadRecord(const std::string& path, const UploadRecord& record);
+
+}
+}
+
+#endif /* _PRIVMX_ENDPOINT_SWIFT_NATIVE_UploadRecord_hpp */
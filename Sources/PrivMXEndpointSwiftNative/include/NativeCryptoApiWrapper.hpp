@@ -85,6 +85,17 @@ public:
 	 */
 	ResultWithError<endpoint::core::Buffer> encryptDataSymmetric(const endpoint::core::Buffer& data,
 										const endpoint::core::Buffer& key);
+	
+	/**
+	 * Encrypts caller-owned data with a symmetric key.
+	 *
+	 * @param data  : `const BufferView&` — data to be encrypted
+	 * @param key : `const endpoint::core::Buffer&` — 256-bit long binary key
+	 *
+	 * @return Encrypted data, wrapped in a`ResultWithError` structure for error handling.
+	 */
+	ResultWithError<endpoint::core::Buffer> encryptDataSymmetric(const BufferView& data,
+										const endpoint::core::Buffer& key);
 	/**
 	 * Decrypts data using AES.
 	 *
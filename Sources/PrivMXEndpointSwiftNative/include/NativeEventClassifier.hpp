@@ -0,0 +1,80 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef _PRIVMX_ENDPOINT_SWIFT_NATIVE_NativeEventClassifier_hpp
+#define _PRIVMX_ENDPOINT_SWIFT_NATIVE_NativeEventClassifier_hpp
+
+#include "PrivMXUtils.hpp"
+
+namespace privmx {
+
+/**
+ * Type of an event taken from the event queue, as returned by `EventClassifier::classifyEvent()`.
+ */
+enum class EventType{
+	Unknown, ///< An event type this version of the wrapper does not know
+	LibBreak,
+	LibPlatformDisconnected,
+	LibConnected,
+	LibDisconnected,
+	ThreadCreated,
+	ThreadUpdated,
+	ThreadDeleted,
+	ThreadStatsChanged,
+	ThreadNewMessage,
+	ThreadMessageUpdated,
+	ThreadMessageDeleted,
+	StoreCreated,
+	StoreUpdated,
+	StoreDeleted,
+	StoreStatsChanged,
+	StoreFileCreated,
+	StoreFileUpdated,
+	StoreFileDeleted,
+	InboxCreated,
+	InboxUpdated,
+	InboxDeleted,
+	InboxEntryCreated,
+	InboxEntryDeleted
+};
+
+using EventTypeVector = std::vector<EventType>;
+
+/**
+ * Identifies events in a single call instead of a chain of `is*Event()` checks.
+ *
+ * The type of the first event of every kind is found by probing, later events of the kind are looked up by their type name.
+ * Once classified, an event is read with the matching `extract*Event()` method of the event handlers.
+ */
+class EventClassifier{
+public:
+	/**
+	 * Gets the type of an event.
+	 *
+	 * @param eventHolder  : `const endpoint::core::EventHolder&`
+	 *
+	 * @return `EventType` of the event, `EventType::Unknown` for events not listed there, wrapped in a `ResultWithError` structure for error handling.
+	 */
+	static ResultWithError<EventType> classifyEvent(const endpoint::core::EventHolder& eventHolder);
+	
+	/**
+	 * Gets the ID of the Thread, Store or Inbox an event concerns, without extracting the whole event.
+	 *
+	 * @param eventHolder  : `const endpoint::core::EventHolder&`
+	 *
+	 * @return The ID of the container, empty for connection and break events, wrapped in a `ResultWithError` structure for error handling.
+	 */
+	static ResultWithError<std::string> getEventContainerId(const endpoint::core::EventHolder& eventHolder);
+};
+
+}
+
+#endif /* _PRIVMX_ENDPOINT_SWIFT_NATIVE_NativeEventClassifier_hpp */
@@ -0,0 +1,108 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef _PRIVMX_ENDPOINT_SWIFT_NATIVE_NativeEventDispatcher_hpp
+#define _PRIVMX_ENDPOINT_SWIFT_NATIVE_NativeEventDispatcher_hpp
+
+#include "PrivMXUtils.hpp"
+#include "NativeEventClassifier.hpp"
+
+namespace privmx {
+
+namespace transfer {
+class EventDispatcher;
+}
+
+/**
+ * Callback receiving the events of a subscription of `NativeEventDispatcher`.
+ *
+ * Called with the opaque `context` of the subscription, the event, valid only during the call, and its type.
+ */
+using EventCallback = void(*)(void* context, const endpoint::core::EventHolder* event, EventType type);
+
+/**
+ * Callback releasing the `context` of an ended subscription of `NativeEventDispatcher`.
+ */
+using EventContextRelease = void(*)(void* context);
+
+/**
+ * Takes the events from the event queue on a native thread and passes them to callbacks subscribed by event type and container.
+ *
+ * Replaces a loop of `NativeEventQueueWrapper::waitEvent()` calls, so the application does not have to block a thread of its own.
+ * Every event is classified once, the events are still passed to the native observers of the wrappers
+ * and the filters and coalescing set on `NativeEventQueueWrapper` apply.
+ * Only one dispatcher can run at a time and no other code should take events from the queue while it runs.
+ * Copies of an instance share the same dispatcher, which is stopped once the last copy is destroyed or `stop()` is called.
+ */
+class NativeEventDispatcher{
+public:
+	/**
+	 * Starts a new dispatcher.
+	 *
+	 * @param workerCount : `int64_t` — number of threads running the callbacks, `0` runs them on the dispatching thread.
+	 * With workers, the events of a single Thread, Store or Inbox are still passed in order, by the same worker.
+	 *
+	 * @return `NativeEventDispatcher` wrapped in a `ResultWithError` structure for error handling.
+	 */
+	static ResultWithError<NativeEventDispatcher> create(int64_t workerCount = 0);
+
+	/**
+	 * Subscribes a callback to events.
+	 *
+	 * A callback must not block for long, as it holds back the following events of its thread.
+	 *
+	 * @param eventType : `EventType` — type of the events, `EventType::Unknown` subscribes to events of every type
+	 * @param containerId : `const std::string&` — ID of the Thread, Store or Inbox of the events, empty for events of every container
+	 * @param callback : `EventCallback` — receives the events
+	 * @param context : `void*` — opaque pointer passed back to `callback` and `release`
+	 * @param release : `EventContextRelease` — called with `context` once the subscription has ended, can be `nullptr`.
+	 * It is not called if subscribing fails.
+	 *
+	 * @return ID of the subscription wrapped in a `ResultWithError` structure for error handling.
+	 */
+	ResultWithError<int64_t> subscribe(EventType eventType,
+									   const std::string& containerId,
+									   EventCallback callback,
+									   void* context,
+									   EventContextRelease release);
+
+	/**
+	 * Ends a subscription.
+	 *
+	 * A callback running at the moment is not interrupted, events not passed to the callback yet are dropped.
+	 *
+	 * @param subscriptionId : `int64_t` — ID returned by `subscribe()`
+	 *
+	 * @return `ResultWithError` structure for error handling.
+	 */
+	ResultWithError<nullptr_t> unsubscribe(int64_t subscriptionId);
+
+	/**
+	 * Stops taking events from the queue, ends all subscriptions and waits for the running callbacks.
+	 *
+	 * @return `ResultWithError` structure for error handling.
+	 */
+	ResultWithError<nullptr_t> stop();
+
+private:
+	std::shared_ptr<transfer::EventDispatcher> getdispatcher(){
+		if (!dispatcher) throw NullApiException();
+		return dispatcher;
+	}
+
+	NativeEventDispatcher() = default;
+
+	std::shared_ptr<transfer::EventDispatcher> dispatcher;
+};
+
+}
+
+#endif /* _PRIVMX_ENDPOINT_SWIFT_NATIVE_NativeEventDispatcher_hpp */
@@ -13,6 +13,7 @@
 #define _PRIVMX_ENDPOINT_SWIFT_NATIVE_NativeEventQueueWrapper_hpp
 
 #include "PrivMXUtils.hpp"
+#include "NativeEventClassifier.hpp"
 
 namespace privmx {
 
@@ -57,6 +58,65 @@ public:
 	 *
 	 */
 	ResultWithError<std::optional<endpoint::core::EventHolder>> getEvent();
+	
+	/**
+	 * Takes up to `maxCount` events from Platform Bridge in a single call.
+	 *
+	 * Waits for the first event at most `timeoutMs`, then drains the events already available without waiting again.
+	 * A break event ends the batch, so `emitBreakEvent()` still interrupts the caller.
+	 *
+	 * @param maxCount : `int64_t` — maximum number of returned events, must be positive
+	 * @param timeoutMs : `int64_t` — time in milliseconds to wait for the first event, `0` returns at once, a negative value waits indefinitely
+	 *
+	 * @return Events in the order they arrived, empty if none arrived in time, wrapped in a `ResultWithError` structure for error handling.
+	 */
+	ResultWithError<EventHolderVector> waitEvents(int64_t maxCount, int64_t timeoutMs);
+	
+	/**
+	 * Sets which types of events are handed over by `waitEvent()`, `getEvent()`, `waitEvents()` and `NativeEventDispatcher`.
+	 *
+	 * Other events are dropped natively, after the native observers of the wrappers have seen them. Break events are never dropped.
+	 * The filter is shared by all instances, like the queue itself.
+	 *
+	 * @param allowed : `const EventTypeVector&` — types passed on, empty for all types not denied
+	 * @param denied : `const EventTypeVector&` — types dropped
+	 *
+	 * @return `ResultWithError` structure for error handling.
+	 */
+	ResultWithError<nullptr_t> setEventTypeFilter(const EventTypeVector& allowed, const EventTypeVector& denied);
+	
+	/**
+	 * Sets the Threads, Stores and Inboxes whose events are handed over, like `setEventTypeFilter()`.
+	 *
+	 * Events not concerning a single container, e.g. connection events, are not affected.
+	 *
+	 * @param allowed : `const StringVector&` — IDs of the containers whose events are passed on, empty for all containers not denied
+	 * @param denied : `const StringVector&` — IDs of the containers whose events are dropped
+	 *
+	 * @return `ResultWithError` structure for error handling.
+	 */
+	ResultWithError<nullptr_t> setContainerFilter(const StringVector& allowed, const StringVector& denied);
+	
+	/**
+	 * Removes the filters set by `setEventTypeFilter()` and `setContainerFilter()`.
+	 *
+	 * @return `ResultWithError` structure for error handling.
+	 */
+	ResultWithError<nullptr_t> clearEventFilter();
+	
+	/**
+	 * Sets the window in which stats and update events are coalesced before they are handed over.
+	 *
+	 * Within the window only the latest `ThreadStatsChanged`, `StoreStatsChanged`, `ThreadUpdated`, `StoreUpdated` and `InboxUpdated`
+	 * event of each Thread, Store or Inbox is kept, and it is handed over when the window of the first one ends.
+	 * Other events of the container hand over the held ones first, so the events of a single container keep their order.
+	 * Applies to `waitEvent()`, `getEvent()`, `waitEvents()` and `NativeEventDispatcher`, and is shared by all instances.
+	 *
+	 * @param windowMs : `int64_t` — length of the window in milliseconds, `0` disables coalescing and hands over the held events
+	 *
+	 * @return `ResultWithError` structure for error handling.
+	 */
+	ResultWithError<nullptr_t> setEventCoalescing(int64_t windowMs);
 private:
 	std::shared_ptr<endpoint::core::EventQueue> api;
 	NativeEventQueueWrapper();
@@ -18,6 +18,12 @@
 
 namespace privmx{
 
+namespace transfer {
+class FileHandleRegistry;
+class Sha256Digest;
+class AsyncFileWriter;
+}
+
 class NativeInboxApiWrapper{
 public:
 	static ResultWithError<NativeInboxApiWrapper> create(NativeConnectionWrapper& connection,
@@ -119,6 +125,20 @@ public:
 											  const endpoint::core::Buffer& data,
 											  const InboxFileHandleVector& inboxFileHandles = InboxFileHandleVector(),
 											  const OptionalString& userPrivKey = std::nullopt);
+
+	/**
+	 * Prepares a request to send caller-owned data to an Inbox.
+	 *
+	 * @param inboxId ID of the Inbox to which the request applies
+	 * @param data view of the entry data
+	 * @param inboxFileHandles optional list of file handles that will be sent with the request
+	 * @param userPrivKey optional sender's private key which can be used later to encrypt data for that sender
+	 * @return int64_t Inbox handle
+	 */
+	ResultWithError<InboxHandle> prepareEntry(const std::string& inboxId,
+											  const BufferView& data,
+											  const InboxFileHandleVector& inboxFileHandles = InboxFileHandleVector(),
+											  const OptionalString& userPrivKey = std::nullopt);
 	
 	/**
 	 * Sends data to an Inbox.
@@ -179,6 +199,43 @@ public:
 										   const InboxFileHandle inboxFileHandle,
 										   const endpoint::core::Buffer& dataChunk);
 
+	/**
+	 * Sends a chunk of caller-owned file data to an Inbox.
+	 *
+	 * @param inboxHandle Handle to the prepared Inbox entry
+	 * @param inboxFileHandle handle to the file where the uploaded chunk belongs
+	 * @param dataChunk view of the file chunk to send
+	 */
+	ResultWithError<nullptr_t> writeToFile(const InboxHandle inboxHandle,
+										   const InboxFileHandle inboxFileHandle,
+										   const BufferView& dataChunk);
+
+
+	/**
+	 * Sends the whole content of a file on the local filesystem to an Inbox.
+	 *
+	 * The source is memory-mapped and sent chunk by chunk, so the resident memory does not grow with the file size.
+	 * The file handle must have been created with the size of the source file.
+	 *
+	 * @param inboxHandle Handle to the prepared Inbox entry
+	 * @param inboxFileHandle handle to the file where the content belongs
+	 * @param filePath path of the source file on the local filesystem
+	 */
+	ResultWithError<nullptr_t> writeFileFromPath(const InboxHandle inboxHandle,
+												 const InboxFileHandle inboxFileHandle,
+												 const std::string& filePath);
+
+	/**
+	 * Sends the whole content of a file on the local filesystem to an Inbox like `writeFileFromPath()`, computing SHA-256 of the content on the way.
+	 *
+	 * @param inboxHandle Handle to the prepared Inbox entry
+	 * @param inboxFileHandle handle to the file where the content belongs
+	 * @param filePath path of the source file on the local filesystem
+	 * @return FileDigest of the sent content, without a file ID which is assigned when the entry is sent
+	 */
+	ResultWithError<FileDigest> writeFileFromPathWithDigest(const InboxHandle inboxHandle,
+															const InboxFileHandle inboxFileHandle,
+															const std::string& filePath);
 
 	/**
 	 * Opens a file to read.
@@ -197,6 +254,18 @@ public:
 	 */
 	ResultWithError<endpoint::core::Buffer> readFromFile(const InboxFileHandle fileHandle, const int64_t length);
 
+	/**
+	 * Reads file data straight into caller-provided memory.
+	 *
+	 * @param fileHandle handle to the file
+	 * @param dst destination memory, at least `capacity` bytes long
+	 * @param capacity maximum size of data to read
+	 * @return number of bytes read, `0` at the end of the file
+	 */
+	ResultWithError<int64_t> readFromFileInto(const InboxFileHandle fileHandle,
+											  void* dst,
+											  size_t capacity);
+
 	/**
 	 * Moves file's read cursor.
 	 *
@@ -206,6 +275,56 @@ public:
 	ResultWithError<nullptr_t> seekInFile(const InboxFileHandle fileHandle,
 										  const int64_t position);
 
+	/**
+	 * Reads a fragment of a file in a single call.
+	 *
+	 * The handle used is kept open and reused by the next `readRange()` of the same file. Handles returned by `openFile()` are not affected.
+	 *
+	 * @param fileId ID of the file to read
+	 * @param offset position of the first byte to read
+	 * @param length maximum size of data to read
+	 * @return core::Buffer buffer with file data, shorter than `length` at the end of the file
+	 */
+	ResultWithError<endpoint::core::Buffer> readRange(const std::string& fileId,
+													  int64_t offset,
+													  int64_t length);
+
+	/**
+	 * Enables caching of decrypted blocks for randomly accessed files.
+	 *
+	 * Reads of handles returned by `openFile()` fetch whole blocks and keep them in a least-recently-used cache shared by all handles,
+	 * so repeated and nearby reads after `seekInFile()` are served from memory.
+	 *
+	 * @param bytes maximum amount of decrypted data kept in memory, `0` (the default) disables the cache
+	 */
+	ResultWithError<nullptr_t> setBlockCacheSize(int64_t bytes);
+
+	/**
+	 * Enables asynchronous writes to prepared Inbox entries.
+	 *
+	 * `writeToFile()` then copies the chunk and returns as soon as it is queued, while a worker thread of the entry writes
+	 * the previous chunk, so preparing the next chunk overlaps with encrypting and sending the previous one.
+	 * A failed write is reported by the next `writeToFile()` of the entry or by `sendEntry()`. Disabled by default.
+	 *
+	 * @param enabled whether `writeToFile()` returns before the chunk is written
+	 */
+	ResultWithError<nullptr_t> setAsyncWrites(bool enabled);
+
+	/**
+	 * Labels an open file handle, e.g. with the call site that opened it.
+	 *
+	 * @param fileHandle handle to the file
+	 * @param label any text identifying the owner of the handle, reported by `getLiveFileHandles()`
+	 */
+	ResultWithError<nullptr_t> setFileHandleLabel(const InboxFileHandle fileHandle, const std::string& label);
+
+	/**
+	 * Lists the handles returned by `openFile()` and not closed yet, oldest first.
+	 *
+	 * @return LiveFileHandleVector snapshots of the handles, with the data buffered natively for each of them
+	 */
+	ResultWithError<LiveFileHandleVector> getLiveFileHandles();
+
 	/**
 	 * Closes the file by given handle.
 	 *
@@ -214,6 +333,52 @@ public:
 	 */
 	ResultWithError<std::string> closeFile(const InboxFileHandle fileHandle);
 
+	/**
+	 * Starts computing SHA-256 of the data read through a handle returned by `openFile()`.
+	 *
+	 * Only data read after this call is covered, in the order it was read; seeking does not reset the digest.
+	 *
+	 * @param fileHandle handle to the file
+	 */
+	ResultWithError<nullptr_t> enableFileDigest(const InboxFileHandle fileHandle);
+
+	/**
+	 * Closes the file by given handle, returning the digest started by `enableFileDigest()`.
+	 *
+	 * Fails without closing the handle if the digest was not enabled.
+	 *
+	 * @param fileHandle handle to the file
+	 * @return FileDigest with the ID of the closed file
+	 */
+	ResultWithError<FileDigest> closeFileWithDigest(const InboxFileHandle fileHandle);
+
+	/**
+	 * Downloads a file attached to an Inbox entry to the local filesystem.
+	 *
+	 * The decrypted content is written natively, without passing through Swift. Reading the next chunk overlaps with writing the previous one.
+	 * The target appears at `filePath` only after the whole content has been written.
+	 *
+	 * @param fileId ID of the file to download
+	 * @param filePath path of the target file on the local filesystem, overwritten if it exists
+	 * @param syncInterval amount of bytes after which the written data is flushed to the storage device, `0` disables syncing
+	 * @return number of bytes written
+	 */
+	ResultWithError<int64_t> downloadFileToPath(const std::string& fileId,
+												const std::string& filePath,
+												int64_t syncInterval = 0);
+
+	/**
+	 * Downloads a file attached to an Inbox entry like `downloadFileToPath()`, computing SHA-256 of the content on the way.
+	 *
+	 * @param fileId ID of the file to download
+	 * @param filePath path of the target file on the local filesystem, overwritten if it exists
+	 * @param syncInterval amount of bytes after which the written data is flushed to the storage device, `0` disables syncing
+	 * @return FileDigest of the written content
+	 */
+	ResultWithError<FileDigest> downloadFileToPathWithDigest(const std::string& fileId,
+															 const std::string& filePath,
+															 int64_t syncInterval = 0);
+
 	/**
 	 * Subscribes for the Inbox module main events.
 	 */
@@ -242,10 +407,32 @@ private:
 		if (!api) throw NullApiException();
 		return api;
 	}
+	std::shared_ptr<transfer::FileHandleRegistry> gethandles(){
+		if (!handles) throw NullApiException();
+		return handles;
+	}
+	std::shared_ptr<transfer::AsyncFileWriter> getwriter(){
+		if (!writer) throw NullApiException();
+		return writer;
+	}
 	NativeInboxApiWrapper() = default;
 	NativeInboxApiWrapper(std::shared_ptr<endpoint::inbox::InboxApi> _api);
+
+	void writeFromPath(const InboxHandle inboxHandle,
+					   const InboxFileHandle inboxFileHandle,
+					   const std::string& filePath,
+					   transfer::Sha256Digest* digest);
+	int64_t downloadToPath(const std::string& fileId,
+						   const std::string& filePath,
+						   int64_t syncInterval,
+						   transfer::Sha256Digest* digest);
+	void write(const InboxHandle inboxHandle,
+			   const InboxFileHandle inboxFileHandle,
+			   const endpoint::core::Buffer& chunk);
 	
 	std::shared_ptr<endpoint::inbox::InboxApi> api;
+	std::shared_ptr<transfer::FileHandleRegistry> handles;
+	std::shared_ptr<transfer::AsyncFileWriter> writer;
 };
 
 class InboxEventHandler {
@@ -17,6 +17,25 @@
 
 namespace privmx {
 
+namespace transfer {
+class FileHandleRegistry;
+class Sha256Digest;
+class DedupIndex;
+class AsyncFileWriter;
+}
+
+/**
+ * Upload made by `NativeStoreApiWrapper::uploadFileRecorded()`, persisted when the upload starts and when it completes.
+ */
+struct UploadRecord{
+	std::string storeId; ///< Store in which the File is being created
+	std::string filePath; ///< Path of the source file
+	int64_t fileSize = 0; ///< Size of the source file when the upload started
+	int64_t modificationTime = 0; ///< Modification time of the source file when the upload started, in seconds since the epoch
+	std::string sha256; ///< Hex SHA-256 of the source, empty until the upload has completed
+	std::string fileId; ///< ID of the created File, empty until the upload has completed
+};
+
 /**
  * C++ wrapper of `privmx::endpoint::store::StoreApi`.
  *
@@ -24,6 +43,8 @@ namespace privmx {
  */
 class NativeStoreApiWrapper{
 	friend class NativeInboxApiWrapper;
+	friend class NativeStoreTransferManager;
+	friend class NativeStoreFileServer;
 public:
 	/**
 	 * Creates a new instance of the class.
@@ -194,6 +215,17 @@ public:
 	ResultWithError<std::nullptr_t> writeToFile(const StoreFileHandle handle,
 												const endpoint::core::Buffer& dataChunk);
 	
+	/**
+	 * Writes a chunk of data to an opened file on the Platform.
+	 *
+	 * @param handle : `const PMXFileHandle` aka `const int64_t` — the handle to an opened file
+	 * @param dataChunk : `const BufferView&` — caller-owned data to be uploaded
+	 *
+	 * @return `ResultWithError` structure for error handling.
+	 */
+	ResultWithError<std::nullptr_t> writeToFile(const StoreFileHandle handle,
+												const BufferView& dataChunk);
+	
 	/**
 	 * Reads from an opened file.
 	 *
@@ -205,6 +237,21 @@ public:
 	ResultWithError<endpoint::core::Buffer> readFromFile(const StoreFileHandle handle,
 														 int64_t length);
 	
+	/**
+	 * Reads from an opened file straight into caller-provided memory.
+	 *
+	 * Unlike `readFromFile()` no intermediate `Buffer` is handed over to the caller.
+	 *
+	 * @param handle : `const StoreFileHandle` aka `const int64_t` — the handle to an opened file
+	 * @param dst : `void*` — destination memory, at least `capacity` bytes long
+	 * @param capacity : `size_t` — maximum amount of bytes to be read
+	 *
+	 * @return The number of bytes read, `0` at the end of the file, wrapped in a`ResultWithError` structure for error handling.
+	 */
+	ResultWithError<int64_t> readFromFileInto(const StoreFileHandle handle,
+											  void* dst,
+											  size_t capacity);
+	
 	/**
 	 * Moves read cursor in an open File.
 	 *
@@ -215,6 +262,99 @@ public:
 	 */
 	ResultWithError<std::nullptr_t> seekInFile(const StoreFileHandle handle,
 											   int64_t position);
+	/**
+	 * Reads a fragment of a File in a single call.
+	 *
+	 * Opening, seeking and reading are done natively, so fetching e.g. headers of many Files costs one bridge crossing each.
+	 * When the pool of open handles is enabled (see `setOpenHandlePoolLimits()`), the handle is kept in it afterwards. Handles held by the caller are never used, so their cursors are not affected.
+	 *
+	 * @param fileId : `const std::string&` — ID of the File to read
+	 * @param offset : `int64_t` — position of the first byte to read
+	 * @param length : `int64_t` — maximum amount of bytes to be read
+	 *
+	 * @return Data read, shorter than `length` at the end of the File, wrapped in a`ResultWithError` structure for error handling.
+	 */
+	ResultWithError<endpoint::core::Buffer> readRange(const std::string& fileId,
+													  int64_t offset,
+													  int64_t length);
+
+	/**
+	 * Enables prefetching for sequentially read Files.
+	 *
+	 * Once a handle has been read a few times in a row with the same length and without seeking, the following chunks
+	 * are downloaded on a background thread and later `readFromFile()` calls are served from that buffer.
+	 * Seeking drops the prefetched data, and so does not reading the handle for 5 seconds.
+	 *
+	 * @param chunkCount : `int64_t` — maximum number of chunks buffered per handle, `0` disables read-ahead
+	 *
+	 * @return `ResultWithError` structure for error handling.
+	 */
+	ResultWithError<std::nullptr_t> setReadAheadDepth(int64_t chunkCount);
+	/**
+	 * Enables caching of decrypted blocks for randomly accessed Files.
+	 *
+	 * Reads of handles returned by `openFile()` fetch whole blocks and keep them in a least-recently-used cache shared by all handles,
+	 * so repeated and nearby reads after `seekInFile()` are served from memory. Handles read sequentially switch to read-ahead when it is enabled.
+	 * Cached blocks of a File are dropped when it is updated or deleted through this instance, or when a `StoreFileUpdatedEvent`
+	 * or `StoreFileDeletedEvent` of it is taken from the event queue through `NativeEventQueueWrapper` or `NativeEventDispatcher`.
+	 * Changes made by other clients are seen only through those events, so enable the cache only while subscribed to the file events
+	 * of the Stores read and draining the queue, otherwise reads of a File changed elsewhere return stale content.
+	 *
+	 * @param bytes : `int64_t` — maximum amount of decrypted data kept in memory, `0` (the default) disables the cache
+	 *
+	 * @return `ResultWithError` structure for error handling.
+	 */
+	ResultWithError<std::nullptr_t> setBlockCacheSize(int64_t bytes);
+	/**
+	 * Enables asynchronous writes to File handles.
+	 *
+	 * `writeToFile()` then copies the chunk and returns as soon as it is queued, while a worker thread of the handle writes
+	 * the previous chunk, so preparing the next chunk overlaps with encrypting and sending the previous one.
+	 * At most one chunk per handle waits in the queue. A failed write is reported by the next `writeToFile()` or `closeFile()`
+	 * of the handle, `closeFile()` then still releases the handle. Disabled by default.
+	 *
+	 * @param enabled : `bool` — whether `writeToFile()` returns before the chunk is written
+	 *
+	 * @return `ResultWithError` structure for error handling.
+	 */
+	ResultWithError<std::nullptr_t> setAsyncWrites(bool enabled);
+	/**
+	 * Sets the limits of the pool of open read handles, which is disabled by default.
+	 *
+	 * `closeFile()` on a handle returned by `openFile()` keeps it open in the pool, and the next `openFile()` or `readRange()`
+	 * of the same File reuses it instead of fetching the File key and metadata again. Pooled handles of a File are dropped
+	 * when it is updated or deleted through this instance, or when a `StoreFileUpdatedEvent` or `StoreFileDeletedEvent` of it
+	 * is taken from the event queue through `NativeEventQueueWrapper` or `NativeEventDispatcher`.
+	 * Enable the pool only while subscribed to the file events of the Stores read and draining the queue, otherwise a File changed
+	 * by another client is read from a stale handle until the handle times out.
+	 *
+	 * @param maxIdleHandles : `int64_t` — maximum number of idle handles kept open, `0` disables pooling (default 0)
+	 * @param idleTimeoutMs : `int64_t` — time in milliseconds after which an idle handle is closed, `0` keeps idle handles until evicted (default 30000)
+	 *
+	 * @return `ResultWithError` structure for error handling.
+	 */
+	ResultWithError<std::nullptr_t> setOpenHandlePoolLimits(int64_t maxIdleHandles, int64_t idleTimeoutMs);
+	/**
+	 * Labels an open File handle, e.g. with the call site that opened it.
+	 *
+	 * The label is reported by `getLiveFileHandles()`, so handles that are never closed can be traced back to their owners.
+	 *
+	 * @param handle : `const StoreFileHandle` aka `const int64_t` — the handle to an open file
+	 * @param label : `const std::string&` — any text identifying the owner of the handle
+	 *
+	 * @return `ResultWithError` structure for error handling.
+	 */
+	ResultWithError<std::nullptr_t> setFileHandleLabel(const StoreFileHandle handle, const std::string& label);
+	/**
+	 * Lists the File handles opened through this instance and not closed yet, oldest first.
+	 *
+	 * Covers handles returned by `openFile()`, `createFile()` and `updateFile()`, with the data buffered natively for each of them.
+	 * Idle handles kept by the pool of open handles are not included.
+	 *
+	 * @return Vector of `LiveFileHandle`, wrapped in a`ResultWithError` structure for error handling.
+	 */
+	ResultWithError<LiveFileHandleVector> getLiveFileHandles();
+
 	
 	/**
 	 * Closes an open File
@@ -224,6 +364,26 @@ public:
 	 * @return The Id of the File, wrapped in a`ResultWithError` structure for error handling.
 	 */
 	ResultWithError<std::string> closeFile(const StoreFileHandle handle);
+	/**
+	 * Starts computing SHA-256 of the data read through or written to an open File handle.
+	 *
+	 * Only data passed after this call is covered, in the order it was read or written; seeking does not reset the digest.
+	 *
+	 * @param handle : `const StoreFileHandle` aka `const int64_t` — the handle to an open file
+	 *
+	 * @return `ResultWithError` structure for error handling.
+	 */
+	ResultWithError<std::nullptr_t> enableFileDigest(const StoreFileHandle handle);
+	/**
+	 * Closes an open File, returning the digest started by `enableFileDigest()`.
+	 *
+	 * Fails without closing the handle if the digest was not enabled.
+	 *
+	 * @param handle : `const StoreFileHandle` aka `const int64_t` — the handle to an open file
+	 *
+	 * @return `FileDigest` with the Id of the File, wrapped in a`ResultWithError` structure for error handling.
+	 */
+	ResultWithError<FileDigest> closeFileWithDigest(const StoreFileHandle handle);
 	
 	
 	/**
@@ -236,7 +396,173 @@ public:
 	 * @return Status of the operation, wrapped in a  `ResultWithError` structure for error handling.
 	 */
 	ResultWithError<std::nullptr_t> deleteFile(const std::string& fileId);
-	
+
+	/**
+	 * Uploads a file from the local filesystem to a Store.
+	 *
+	 * Creates the File, writes its content and closes it in a single call.
+	 * The source is memory-mapped and fed to the Platform chunk by chunk, so the resident memory does not grow with the file size.
+	 *
+	 * @param storeId : `const std::string&` — in which Store should the File be created
+	 * @param publicMeta public (unencrypted) metadata
+	 * @param privateMeta private (encrypted) metadata
+	 * @param filePath : `const std::string&` — path of the source file on the local filesystem
+	 *
+	 * @return The Id of the created File, wrapped in a`ResultWithError` structure for error handling.
+	 */
+	ResultWithError<std::string> uploadFile(const std::string& storeId,
+											const endpoint::core::Buffer& publicMeta,
+											const endpoint::core::Buffer& privateMeta,
+											const std::string& filePath);
+
+	/**
+	 * Uploads a file from the local filesystem to a Store like `uploadFile()`, computing SHA-256 of the content on the way.
+	 *
+	 * @param storeId : `const std::string&` — in which Store should the File be created
+	 * @param publicMeta public (unencrypted) metadata
+	 * @param privateMeta private (encrypted) metadata
+	 * @param filePath : `const std::string&` — path of the source file on the local filesystem
+	 *
+	 * @return `FileDigest` with the Id of the created File, wrapped in a`ResultWithError` structure for error handling.
+	 */
+	ResultWithError<FileDigest> uploadFileWithDigest(const std::string& storeId,
+													 const endpoint::core::Buffer& publicMeta,
+													 const endpoint::core::Buffer& privateMeta,
+													 const std::string& filePath);
+
+	/**
+	 * Enables skipping uploads of content already present in the target Store.
+	 *
+	 * Uploads from a path (`uploadFile()`, `uploadFileWithDigest()` and the transfer manager) first hash the source and look it up
+	 * in a local index of uploaded content. A File listed there is returned instead of uploading again if it still exists, has
+	 * the same size and metadata and its leading 64 KiB still match the uploaded content. Successful uploads from a path and `uploadFileRecorded()` add their Files to the index.
+	 * Files updated or deleted through this instance or reported by Store events taken from the event queue are dropped from it.
+	 *
+	 * @param indexPath : `const std::string&` — file in which the index is kept between sessions, empty to keep it in memory only
+	 *
+	 * @return `ResultWithError` structure for error handling.
+	 */
+	ResultWithError<std::nullptr_t> enableUploadDeduplication(const std::string& indexPath);
+	/**
+	 * Disables skipping of duplicate uploads and forgets the in-memory index. A file given to `enableUploadDeduplication()` is kept.
+	 *
+	 * @return `ResultWithError` structure for error handling.
+	 */
+	ResultWithError<std::nullptr_t> disableUploadDeduplication();
+
+	/**
+	 * Uploads a file from the local filesystem to a Store, deflating its content on the client.
+	 *
+	 * The content is compressed in independent frames and stored behind a small header that marks the File as compressed,
+	 * so it is read back transparently once `setTransparentDecompression()` is enabled, including `seekInFile()` to any position.
+	 * Clients without it see the compressed content, and `getFile()` reports the compressed size.
+	 *
+	 * @param storeId : `const std::string&` — in which Store should the File be created
+	 * @param publicMeta public (unencrypted) metadata
+	 * @param privateMeta private (encrypted) metadata
+	 * @param filePath : `const std::string&` — path of the source file on the local filesystem
+	 * @param level : `int64_t` — zlib compression level from `1` (fastest) to `9` (smallest)
+	 *
+	 * @return The Id of the created File, wrapped in a`ResultWithError` structure for error handling.
+	 */
+	ResultWithError<std::string> uploadFileCompressed(const std::string& storeId,
+													  const endpoint::core::Buffer& publicMeta,
+													  const endpoint::core::Buffer& privateMeta,
+													  const std::string& filePath,
+													  int64_t level);
+	/**
+	 * Enables reading Files uploaded by `uploadFileCompressed()` as their original content.
+	 *
+	 * Applies to `openFile()`, `readRange()` and `downloadFileToPath()`. Reading a compressed File inflates only the frames
+	 * covering the requested range, such reads bypass read-ahead and the block cache. Disabled by default.
+	 *
+	 * @param enabled : `bool` — whether compressed Files are decompressed on read
+	 *
+	 * @return `ResultWithError` structure for error handling.
+	 */
+	ResultWithError<std::nullptr_t> setTransparentDecompression(bool enabled);
+
+	/**
+	 * Uploads a file to a Store, pulling its content from a callback.
+	 *
+	 * The callback is invoked on a background thread, so the next chunk is produced while the previous one is being encrypted and sent.
+	 *
+	 * @param storeId : `const std::string&` — in which Store should the File be created
+	 * @param publicMeta public (unencrypted) metadata
+	 * @param privateMeta private (encrypted) metadata
+	 * @param size : `int64_t` — the size of the file
+	 * @param reader : `ChunkReaderCallback` — supplies consecutive parts of the content
+	 * @param context : `void*` — opaque pointer passed back to `reader`
+	 *
+	 * @return The Id of the created File, wrapped in a`ResultWithError` structure for error handling.
+	 */
+	ResultWithError<std::string> uploadFile(const std::string& storeId,
+											const endpoint::core::Buffer& publicMeta,
+											const endpoint::core::Buffer& privateMeta,
+											int64_t size,
+											ChunkReaderCallback reader,
+											void* context);
+
+	/**
+	 * Uploads a file from the local filesystem to a Store at most once, keeping a record of the upload in a file.
+	 *
+	 * The record is written when the upload starts and replaced when it completes. If it shows that the same unchanged source
+	 * has already been uploaded to the same Store and that File still exists, its ID is returned without uploading again,
+	 * so the call can be safely repeated, e.g. after a restart. An interrupted upload is not continued, it starts over.
+	 * Failing to update the record after the File has been created is not reported, the File ID is returned regardless.
+	 * The record is kept after completion — remove it once the File ID has been stored elsewhere.
+	 *
+	 * @param storeId : `const std::string&` — in which Store should the File be created
+	 * @param publicMeta public (unencrypted) metadata
+	 * @param privateMeta private (encrypted) metadata
+	 * @param filePath : `const std::string&` — path of the source file on the local filesystem
+	 * @param recordPath : `const std::string&` — path of the record file
+	 *
+	 * @return The Id of the created or previously uploaded File, wrapped in a`ResultWithError` structure for error handling.
+	 */
+	ResultWithError<std::string> uploadFileRecorded(const std::string& storeId,
+													const endpoint::core::Buffer& publicMeta,
+													const endpoint::core::Buffer& privateMeta,
+													const std::string& filePath,
+													const std::string& recordPath);
+
+	/**
+	 * Reads a record written by `uploadFileRecorded()`.
+	 *
+	 * @param recordPath : `const std::string&` — path of the record file
+	 *
+	 * @return The record, or an empty optional if there is no valid one, wrapped in a`ResultWithError` structure for error handling.
+	 */
+	ResultWithError<std::optional<UploadRecord>> readUploadRecord(const std::string& recordPath);
+
+	/**
+	 * Downloads a File from a Store to the local filesystem.
+	 *
+	 * The decrypted content is written natively, without passing through Swift. Reading the next chunk overlaps with writing the previous one.
+	 * The target appears at `filePath` only after the whole content has been written.
+	 *
+	 * @param fileId : `const std::string&` — ID of the File to download
+	 * @param filePath : `const std::string&` — path of the target file on the local filesystem, overwritten if it exists
+	 * @param syncInterval : `int64_t` — amount of bytes after which the written data is flushed to the storage device, `0` disables syncing
+	 *
+	 * @return The number of bytes written, wrapped in a`ResultWithError` structure for error handling.
+	 */
+	ResultWithError<int64_t> downloadFileToPath(const std::string& fileId,
+												const std::string& filePath,
+												int64_t syncInterval = 0);
+	/**
+	 * Downloads a File from a Store to the local filesystem like `downloadFileToPath()`, computing SHA-256 of the content on the way.
+	 *
+	 * @param fileId : `const std::string&` — ID of the File to download
+	 * @param filePath : `const std::string&` — path of the target file on the local filesystem, overwritten if it exists
+	 * @param syncInterval : `int64_t` — amount of bytes after which the written data is flushed to the storage device, `0` disables syncing
+	 *
+	 * @return `FileDigest` of the written content, wrapped in a`ResultWithError` structure for error handling.
+	 */
+	ResultWithError<FileDigest> downloadFileToPathWithDigest(const std::string& fileId,
+															 const std::string& filePath,
+															 int64_t syncInterval = 0);
+
 	ResultWithError<std::nullptr_t> subscribeForStoreEvents();
 	ResultWithError<std::nullptr_t> unsubscribeFromStoreEvents();
 	ResultWithError<std::nullptr_t> subscribeForFileEvents(const std::string& storeId);
@@ -247,11 +573,54 @@ private:
 		if (!api) throw NullApiException();
 		return api;
 	}
+	std::shared_ptr<transfer::FileHandleRegistry> gethandles(){
+		if (!handles) throw NullApiException();
+		return handles;
+	}
+	std::shared_ptr<transfer::DedupIndex> getdedup(){
+		if (!dedup) throw NullApiException();
+		return dedup;
+	}
+	std::shared_ptr<transfer::AsyncFileWriter> getwriter(){
+		if (!writer) throw NullApiException();
+		return writer;
+	}
 	
 	NativeStoreApiWrapper() = default;
 	NativeStoreApiWrapper(NativeConnectionWrapper& connection);
-	
+
+	std::string uploadFromPath(const std::string& storeId,
+							   const endpoint::core::Buffer& publicMeta,
+							   const endpoint::core::Buffer& privateMeta,
+							   const std::string& filePath,
+							   const std::function<void(int64_t)>& progress,
+							   transfer::Sha256Digest* digest = nullptr);
+	int64_t downloadToPath(const std::string& fileId,
+						   const std::string& filePath,
+						   int64_t syncInterval,
+						   const std::function<void(int64_t)>& progress,
+						   transfer::Sha256Digest* digest = nullptr);
+	std::string uploadContent(const std::string& storeId,
+							  const endpoint::core::Buffer& publicMeta,
+							  const endpoint::core::Buffer& privateMeta,
+							  int64_t size,
+							  const std::function<void(StoreFileHandle)>& writeContent);
+	void pipelinedWrite(StoreFileHandle handle,
+						int64_t size,
+						const std::function<int64_t(char*, int64_t)>& read);
+	bool isRecordedFile(const UploadRecord& record);
+	std::optional<std::string> findDuplicate(const std::string& storeId,
+											 const endpoint::core::Buffer& publicMeta,
+											 const endpoint::core::Buffer& privateMeta,
+											 int64_t size,
+											 const std::string& sha256);
+	std::string closeHandle(StoreFileHandle handle);
+	void write(StoreFileHandle handle, const endpoint::core::Buffer& chunk);
+
 	std::shared_ptr<endpoint::store::StoreApi> api;
+	std::shared_ptr<transfer::FileHandleRegistry> handles;
+	std::shared_ptr<transfer::DedupIndex> dedup;
+	std::shared_ptr<transfer::AsyncFileWriter> writer;
 	
 };
 
@@ -0,0 +1,83 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef _PRIVMX_ENDPOINT_SWIFT_NATIVE_NativeStoreFileServer_hpp
+#define _PRIVMX_ENDPOINT_SWIFT_NATIVE_NativeStoreFileServer_hpp
+
+#include "PrivMXUtils.hpp"
+#include "NativeStoreApiWrapper.hpp"
+
+namespace privmx {
+
+namespace transfer {
+class StoreFileServer;
+}
+
+/**
+ * HTTP server on the loopback interface streaming decrypted Store files to media players.
+ *
+ * Every File is available under the URL returned by `getFileUrl()`, which supports `Range` requests and persistent connections.
+ * The URLs contain a random token, so other local processes cannot read the Files. Copies of an instance share the same server,
+ * which is stopped once the last copy is destroyed or `stop()` is called.
+ * Files uploaded with `uploadFileCompressed()` are served decompressed while transparent decompression is enabled on the Store Api.
+ */
+class NativeStoreFileServer{
+public:
+	/**
+	 * Starts a new server.
+	 *
+	 * @param storeApi : `NativeStoreApiWrapper&` — the Store Api used to read the Files
+	 * @param port : `int64_t` — the loopback port to listen on, `0` picks a free one
+	 *
+	 * @return `NativeStoreFileServer` wrapped in a `ResultWithError` structure for error handling.
+	 */
+	static ResultWithError<NativeStoreFileServer> create(NativeStoreApiWrapper& storeApi,
+														 int64_t port = 0);
+
+	/**
+	 * Gets the port the server listens on.
+	 *
+	 * @return The port wrapped in a `ResultWithError` structure for error handling.
+	 */
+	ResultWithError<int64_t> getPort();
+
+	/**
+	 * Gets the URL under which a File is served.
+	 *
+	 * Append `&type=` with a MIME type to set the `Content-Type` of the responses, which some players rely on.
+	 *
+	 * @param fileId : `const std::string&` — ID of the File
+	 *
+	 * @return The URL wrapped in a `ResultWithError` structure for error handling.
+	 */
+	ResultWithError<std::string> getFileUrl(const std::string& fileId);
+
+	/**
+	 * Stops the server and aborts the ongoing responses.
+	 *
+	 * @return `ResultWithError` structure for error handling.
+	 */
+	ResultWithError<nullptr_t> stop();
+
+private:
+	std::shared_ptr<transfer::StoreFileServer> getserver(){
+		if (!server) throw NullApiException();
+		return server;
+	}
+
+	NativeStoreFileServer() = default;
+
+	std::shared_ptr<transfer::StoreFileServer> server;
+};
+
+}
+
+#endif /* _PRIVMX_ENDPOINT_SWIFT_NATIVE_NativeStoreFileServer_hpp */
@@ -0,0 +1,174 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef _PRIVMX_ENDPOINT_SWIFT_NATIVE_NativeStoreTransferManager_hpp
+#define _PRIVMX_ENDPOINT_SWIFT_NATIVE_NativeStoreTransferManager_hpp
+
+#include "PrivMXUtils.hpp"
+#include "NativeStoreApiWrapper.hpp"
+
+namespace privmx {
+
+namespace transfer {
+class TransferScheduler;
+}
+
+/**
+ * Lifecycle stage of a queued transfer.
+ */
+enum class TransferJobState{
+	Queued,
+	Running,
+	Completed,
+	Failed,
+	Cancelled
+};
+
+/**
+ * Snapshot of a single transfer.
+ */
+struct TransferJobStatus{
+	int64_t jobId = 0; ///< ID of the job, as returned when it was queued
+	TransferJobState state = TransferJobState::Queued; ///< Current stage of the job
+	int64_t bytesTransferred = 0; ///< Amount of file content moved so far
+	std::string fileId; ///< ID of the uploaded or downloaded File, set once the job has completed
+	std::optional<InternalError> error; ///< Reason of the failure, set if the job has failed
+};
+
+/**
+ * Aggregate counters of a transfer manager.
+ */
+struct TransferStats{
+	int64_t queuedJobs = 0; ///< Jobs waiting for a free worker
+	int64_t runningJobs = 0; ///< Jobs being transferred right now
+	int64_t completedJobs = 0; ///< Jobs finished successfully since the manager was created
+	int64_t failedJobs = 0; ///< Jobs finished with an error since the manager was created
+	int64_t cancelledJobs = 0; ///< Jobs cancelled before they started
+	int64_t bytesTransferred = 0; ///< Amount of file content moved by all jobs
+	double bytesPerSecond = 0; ///< Average throughput over the time at least one job was running
+	int64_t concurrencyLimit = 0; ///< Maximum number of jobs running at the same time
+};
+
+/**
+ * Queues Store file uploads and downloads and runs them on a pool of native worker threads.
+ *
+ * Jobs with a higher priority start first. Copies of an instance share the same queue,
+ * which is shut down once the last copy is destroyed: queued jobs are then cancelled and running ones are awaited.
+ */
+class NativeStoreTransferManager{
+public:
+	/**
+	 * Creates a new instance of the class.
+	 *
+	 * @param storeApi : `NativeStoreApiWrapper&` — the Store Api used to perform the transfers
+	 * @param concurrencyLimit : `int64_t` — maximum number of transfers running at the same time
+	 *
+	 * @return `NativeStoreTransferManager` wrapped in a `ResultWithError` structure for error handling.
+	 */
+	static ResultWithError<NativeStoreTransferManager> create(NativeStoreApiWrapper& storeApi,
+															  int64_t concurrencyLimit);
+
+	/**
+	 * Queues an upload of a file from the local filesystem to a Store.
+	 *
+	 * @param storeId : `const std::string&` — in which Store should the File be created
+	 * @param publicMeta public (unencrypted) metadata
+	 * @param privateMeta private (encrypted) metadata
+	 * @param filePath : `const std::string&` — path of the source file on the local filesystem
+	 * @param priority : `int64_t` — jobs with a higher value start first
+	 *
+	 * @return The ID of the job, wrapped in a `ResultWithError` structure for error handling.
+	 */
+	ResultWithError<int64_t> enqueueUpload(const std::string& storeId,
+										   const endpoint::core::Buffer& publicMeta,
+										   const endpoint::core::Buffer& privateMeta,
+										   const std::string& filePath,
+										   int64_t priority = 0);
+
+	/**
+	 * Queues a download of a File from a Store to the local filesystem.
+	 *
+	 * @param fileId : `const std::string&` — ID of the File to download
+	 * @param filePath : `const std::string&` — path of the target file on the local filesystem, overwritten if it exists
+	 * @param priority : `int64_t` — jobs with a higher value start first
+	 *
+	 * @return The ID of the job, wrapped in a `ResultWithError` structure for error handling.
+	 */
+	ResultWithError<int64_t> enqueueDownload(const std::string& fileId,
+											 const std::string& filePath,
+											 int64_t priority = 0);
+
+	/**
+	 * Changes the maximum number of transfers running at the same time. Running transfers are never interrupted.
+	 *
+	 * @param concurrencyLimit : `int64_t` — new limit, must be positive
+	 *
+	 * @return `ResultWithError` structure for error handling.
+	 */
+	ResultWithError<nullptr_t> setConcurrencyLimit(int64_t concurrencyLimit);
+
+	/**
+	 * Cancels a job that has not started yet.
+	 *
+	 * @param jobId : `int64_t` — ID of the job
+	 *
+	 * @return `true` if the job was cancelled, `false` if it is already running or finished, wrapped in a `ResultWithError` structure for error handling.
+	 */
+	ResultWithError<bool> cancelJob(int64_t jobId);
+
+	/**
+	 * Gets the current status of a job.
+	 *
+	 * @param jobId : `int64_t` — ID of the job
+	 *
+	 * @return `TransferJobStatus` wrapped in a `ResultWithError` structure for error handling.
+	 */
+	ResultWithError<TransferJobStatus> getJobStatus(int64_t jobId);
+
+	/**
+	 * Blocks until a job is finished.
+	 *
+	 * @param jobId : `int64_t` — ID of the job
+	 *
+	 * @return The final `TransferJobStatus` wrapped in a `ResultWithError` structure for error handling.
+	 */
+	ResultWithError<TransferJobStatus> waitForJob(int64_t jobId);
+
+	/**
+	 * Gets the aggregate counters and throughput of all jobs.
+	 *
+	 * @return `TransferStats` wrapped in a `ResultWithError` structure for error handling.
+	 */
+	ResultWithError<TransferStats> getStats();
+
+	/**
+	 * Drops the statuses of finished jobs, which are otherwise kept until the manager is destroyed.
+	 *
+	 * @return `ResultWithError` structure for error handling.
+	 */
+	ResultWithError<nullptr_t> forgetFinishedJobs();
+
+private:
+	std::shared_ptr<transfer::TransferScheduler> getscheduler(){
+		if (!scheduler) throw NullApiException();
+		return scheduler;
+	}
+
+	NativeStoreTransferManager() = default;
+	NativeStoreTransferManager(NativeStoreApiWrapper& storeApi, size_t concurrencyLimit);
+
+	NativeStoreApiWrapper storeApi;
+	std::shared_ptr<transfer::TransferScheduler> scheduler;
+};
+
+}
+
+#endif /* _PRIVMX_ENDPOINT_SWIFT_NATIVE_NativeStoreTransferManager_hpp */
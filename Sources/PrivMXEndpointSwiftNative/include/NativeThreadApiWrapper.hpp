@@ -123,6 +123,21 @@ public:
 											 const endpoint::core::Buffer& publicMeta,
 											 const endpoint::core::Buffer& privateMeta,
 											 const endpoint::core::Buffer& data);
+	
+	/**
+	 * Sends a message in a thread
+	 *
+	 * @param threadId : `const std::string&` — Thread in which the message is sent
+	 * @param publicMeta : `const privmx::BufferView&` — Meta_data that will not be encrypted on the Platform
+	 * @param privateMeta : `const privmx::BufferView&` — Meta_data that will be encrypted on the Platform
+	 * @param data : `const privmx::BufferView&` — Actual message
+	 *
+	 * @return Id of the created message, wrappend in a `ResultWithError` structure for error handling.
+	 */
+	ResultWithError<std::string> sendMessage(const std::string& threadId,
+											 const BufferView& publicMeta,
+											 const BufferView& privateMeta,
+											 const BufferView& data);
 	/**
 	 * Deletes the specified Message.
 	 *
@@ -0,0 +1,124 @@
+//
+// PrivMX Endpoint Swift
+// Copyright © 2024 Simplito sp. z o.o.
+//
+// This file is part of PrivMX Platform (https://privmx.dev).
+// This software is Licensed under the MIT License.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef _PRIVMX_ENDPOINT_SWIFT_NATIVE_NativeTransferConfig_hpp
+#define _PRIVMX_ENDPOINT_SWIFT_NATIVE_NativeTransferConfig_hpp
+
+#include "PrivMXUtils.hpp"
+
+namespace privmx {
+
+/**
+ * Usage of the process-wide memory budget of file transfers.
+ */
+struct TransferMemoryStats{
+	int64_t budget = 0; ///< Configured budget in bytes, `0` if unlimited
+	int64_t reservedBytes = 0; ///< Memory currently held by in-flight chunks, prefetched chunks and cached blocks
+	int64_t peakReservedBytes = 0; ///< Highest value of `reservedBytes` seen so far
+	int64_t waitCount = 0; ///< Number of chunk allocations that had to wait for memory
+};
+
+/**
+ * Counters of the pool of chunk staging buffers used by file transfers.
+ */
+struct TransferBufferPoolStats{
+	int64_t heapAllocations = 0; ///< Chunk buffers allocated on the heap so far, including the copy of every chunk passed to or returned by the Api
+	int64_t reusedBuffers = 0; ///< Chunk buffers served from the pool so far
+	int64_t idleBuffers = 0; ///< Buffers kept in the pool for reuse
+	int64_t idleBytes = 0; ///< Memory held by the idle buffers
+};
+
+/**
+ * Chunk sizes chosen for native uploads and downloads, see `NativeTransferConfig::setChunkSizeTuning()`.
+ */
+struct TransferChunkStats{
+	bool tuning = false; ///< Whether chunk sizes are tuned, otherwise the default chunk size is used
+	int64_t minChunkSize = 0; ///< Lower bound of tuned chunk sizes
+	int64_t maxChunkSize = 0; ///< Upper bound of tuned chunk sizes
+	int64_t uploadChunkSize = 0; ///< Size of the next uploaded chunk
+	int64_t downloadChunkSize = 0; ///< Size of the next downloaded chunk
+	double uploadBytesPerSecond = 0; ///< Throughput of a single upload measured at the last tuning step
+	double downloadBytesPerSecond = 0; ///< Throughput of a single download measured at the last tuning step
+	int64_t uploadSamples = 0; ///< Uploaded chunks measured since tuning was configured
+	int64_t downloadSamples = 0; ///< Downloaded chunks measured since tuning was configured
+};
+
+/**
+ * Process-wide settings of the native file transfers, shared by all Store and Inbox Api instances.
+ */
+class NativeTransferConfig{
+public:
+	/**
+	 * Limits the memory held by in-flight file chunks across all transfers.
+	 *
+	 * Before allocating a chunk, every transfer reserves its size. When the budget is exhausted the transfer waits
+	 * for others to return memory instead of failing. Chunks returned to Swift stop counting once the call returns.
+	 * Read-ahead buffers and cached blocks count as well: blocks are cached only while the budget has room and are evicted
+	 * when a transfer has to wait, and chunks prefetched for a handle that is not read for 5 seconds are dropped.
+	 * The budget is unlimited by default.
+	 *
+	 * @param bytes : `int64_t` — the budget in bytes, `0` removes the limit
+	 *
+	 * @return `ResultWithError` structure for error handling.
+	 */
+	static ResultWithError<nullptr_t> setMemoryBudget(int64_t bytes);
+
+	/**
+	 * Gets the current usage of the memory budget.
+	 *
+	 * @return `TransferMemoryStats` wrapped in a `ResultWithError` structure for error handling.
+	 */
+	static ResultWithError<TransferMemoryStats> getMemoryStats();
+
+	/**
+	 * Gets the counters of the pool of chunk staging buffers.
+	 *
+	 * Transfers moving chunks of a steady size reuse pooled staging buffers. Every chunk passed to or returned by the Api is still
+	 * copied into its own allocation, so `heapAllocations` keeps growing by about one per chunk once the pool is warm.
+	 *
+	 * @return `TransferBufferPoolStats` wrapped in a `ResultWithError` structure for error handling.
+	 */
+	static ResultWithError<TransferBufferPoolStats> getBufferPoolStats();
+
+	/**
+	 * Frees the buffers kept in the pool for reuse, e.g. in response to a memory warning.
+	 *
+	 * @return `ResultWithError` structure for error handling.
+	 */
+	static ResultWithError<nullptr_t> trimBufferPool();
+
+	/**
+	 * Enables adapting the chunk size of native uploads and downloads to the link.
+	 *
+	 * Uploads and downloads from and to a path, `uploadFile()` with a chunk reader and transfer manager jobs measure every chunk.
+	 * Starting at `minChunkSize`, the size is doubled while the throughput grows and reduced when it drops or when a single chunk
+	 * takes longer than two seconds. Uploads and downloads are tuned separately. Enabling or reconfiguring restarts the tuning.
+	 * Disabled by default, in which case 1 MiB chunks are used.
+	 *
+	 * @param enabled : `bool` — whether chunk sizes are tuned
+	 * @param minChunkSize : `int64_t` — lower bound of the chunk size in bytes (default 256 KiB)
+	 * @param maxChunkSize : `int64_t` — upper bound of the chunk size in bytes (default 8 MiB)
+	 *
+	 * @return `ResultWithError` structure for error handling.
+	 */
+	static ResultWithError<nullptr_t> setChunkSizeTuning(bool enabled, int64_t minChunkSize, int64_t maxChunkSize);
+
+	/**
+	 * Gets the chunk sizes currently used by native transfers and the throughput they were chosen for.
+	 *
+	 * @return `TransferChunkStats` wrapped in a `ResultWithError` structure for error handling.
+	 */
+	static ResultWithError<TransferChunkStats> getChunkStats();
+};
+
+}
+
+#endif /* _PRIVMX_ENDPOINT_SWIFT_NATIVE_NativeTransferConfig_hpp */
@@ -12,6 +12,7 @@
 #ifndef _PRIVMX_ENDPOINT_SWIFT_NATIVE_PRIVMXUTILS
 #define _PRIVMX_ENDPOINT_SWIFT_NATIVE_PRIVMXUTILS
 
+#include <functional>
 #include <optional>
 #include <string>
 #include <vector>
@@ -51,6 +52,15 @@ using InboxFileHandleVector = std::vector<InboxFileHandle>;
 using StringVector = std::vector<std::string>;
 using OptionalString = std::optional<std::string>;
 using UserWithPubKeyVector = std::vector<endpoint::core::UserWithPubKey>;
+using EventHolderVector = std::vector<endpoint::core::EventHolder>;
+
+/**
+ * Callback supplying the content of an upload.
+ *
+ * Called with the opaque `context`, a destination buffer and its capacity.
+ * Returns the number of bytes written to the buffer, `0` at the end of the data and a negative value on failure.
+ */
+using ChunkReaderCallback = int64_t(*)(void* context, char* buffer, int64_t capacity);
 
 using OptionalInboxFilesConfig = std::optional<endpoint::inbox::FilesConfig>;
 
@@ -67,6 +77,40 @@ using InboxList = endpoint::core::PagingList<endpoint::inbox::Inbox>;
 using InboxEntryList = endpoint::core::PagingList<endpoint::inbox::InboxEntry>;
 
 
+/**
+ * Non-owning view of contiguous memory.
+ *
+ * Lets callers pass their own memory to write-side methods, which convert it to a `Buffer` only where the core library requires one.
+ * The memory must stay valid for the duration of the call.
+ */
+struct BufferView{
+	const char* data = nullptr; ///< Start of the viewed memory
+	size_t size = 0; ///< Length of the viewed memory in bytes
+};
+
+/**
+ * Snapshot of a file handle that has not been closed yet.
+ */
+struct LiveFileHandle{
+	int64_t handle = 0; ///< The handle itself
+	std::string fileId; ///< File read or updated through the handle, empty for handles of new files
+	std::string label; ///< Label set by the owner of the handle, e.g. the call site that opened it
+	bool writing = false; ///< Whether the handle writes the content of a file
+	int64_t bufferedBytes = 0; ///< Data held natively for the handle, e.g. prefetched chunks
+	int64_t ageMs = 0; ///< Time since the handle was opened, in milliseconds
+};
+
+using LiveFileHandleVector = std::vector<LiveFileHandle>;
+
+/**
+ * SHA-256 of file content computed while it was transferred.
+ */
+struct FileDigest{
+	std::string fileId; ///< The transferred file
+	int64_t size = 0; ///< Number of bytes covered by the digest
+	std::string sha256; ///< Lowercase hex SHA-256 of the covered bytes
+};
+
 /**
 * Holds data extracted from the thrown Exception
 **/
@@ -127,6 +171,11 @@ static OptionalContainerPolicyWithoutItem makeOptional(const endpoint::core::Con
 	return std::make_optional(val);
 }
 
+/// Creates a `BufferView` of the provided memory
+static BufferView makeBufferView(const void* data, size_t size){
+	return BufferView{static_cast<const char*>(data), size};
+}
+
 /// Exposes vector comaprison in Swift
 static bool compareVectors(const StringVector& lhs, const StringVector& rhs){
 	return lhs == rhs;